@@ -1,3 +1,6 @@
+#include "thread_pool.hpp"
+#include "worker_local.hpp"
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -284,6 +287,89 @@ void pi_with_futures()
     cout << "Elapsed = " << elapsed_time << "ms" << endl;
 }
 
+void pi_with_thread_pool()
+{
+    cout << "Pi calculation started! Thread pool - when_all + then" << endl;
+    const auto start = chrono::high_resolution_clock::now();
+
+    const unsigned int number_of_cores = std::thread::hardware_concurrency();
+    const uintmax_t chunk_size = N / number_of_cores;
+
+    ThreadPool thread_pool(number_of_cores);
+
+    std::vector<Future<uintmax_t>> hits_vec;
+
+    for (unsigned int i = 0; i < number_of_cores; ++i)
+    {
+        hits_vec.push_back(thread_pool.submit([chunk_size] { return calculate_hits(chunk_size); }));
+    }
+
+    // reduction runs on the pool when the last partial result arrives
+    auto f_pi = when_all(std::move(hits_vec)).then([](std::vector<Future<uintmax_t>> f_hits) {
+        uintmax_t hits = 0;
+        for (auto& f : f_hits)
+            hits += f.get();
+
+        return static_cast<double>(hits) / N * 4;
+    });
+
+    const double pi = f_pi.get();
+
+    const auto end = chrono::high_resolution_clock::now();
+    const auto elapsed_time = chrono::duration_cast<chrono::milliseconds>(end - start).count();
+
+    cout << "Pi = " << pi << endl;
+    cout << "Elapsed = " << elapsed_time << "ms" << endl;
+}
+
+void pi_with_worker_local()
+{
+    cout << "Pi calculation started! Thread pool - worker-local RNGs & counters" << endl;
+    const auto start = chrono::high_resolution_clock::now();
+
+    const unsigned int number_of_cores = std::thread::hardware_concurrency();
+    const uintmax_t tasks_count = number_of_cores * 64;
+    const uintmax_t chunk_size = N / tasks_count;
+
+    ThreadPool thread_pool(number_of_cores);
+
+    // every worker seeds its generator once - tasks only draw samples
+    WorkerLocal<std::mt19937_64> rnd_gens{thread_pool, [](size_t slot) { return std::mt19937_64(slot); }};
+    WorkerLocal<uintmax_t> hits{thread_pool};
+
+    std::vector<Future<void>> f_tasks;
+
+    for (uintmax_t i = 0; i < tasks_count; ++i)
+    {
+        f_tasks.push_back(thread_pool.submit([chunk_size, &rnd_gens, &hits] {
+            auto& rnd_gen = rnd_gens.local();
+            std::uniform_real_distribution<double> rnd(0, 1.0);
+
+            uintmax_t local_hits{};
+            for (uintmax_t n = 0; n < chunk_size; ++n)
+            {
+                double x = rnd(rnd_gen);
+                double y = rnd(rnd_gen);
+                if (x * x + y * y < 1)
+                    local_hits++;
+            }
+
+            hits.local() += local_hits;
+        }));
+    }
+
+    for (auto& f : f_tasks)
+        f.get();
+
+    const double pi = static_cast<double>(hits.combine_all(uintmax_t{}, std::plus<>{})) / (chunk_size * tasks_count) * 4;
+
+    const auto end = chrono::high_resolution_clock::now();
+    const auto elapsed_time = chrono::duration_cast<chrono::milliseconds>(end - start).count();
+
+    cout << "Pi = " << pi << endl;
+    cout << "Elapsed = " << elapsed_time << "ms" << endl;
+}
+
 int main()
 {
     single_thread_pi();
@@ -307,4 +393,12 @@ int main()
     std::cout << "-------------\n";
 
     pi_with_futures();
+
+    std::cout << "-------------\n";
+
+    pi_with_thread_pool();
+
+    std::cout << "-------------\n";
+
+    pi_with_worker_local();
 }
\ No newline at end of file
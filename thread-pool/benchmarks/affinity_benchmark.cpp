@@ -0,0 +1,128 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * ThreadPool: memory-bound tasks with & without pinning
+ *
+ * Each worker owns a buffer that is first touched (so allocated)
+ * by the worker itself - unpinned workers may migrate away from it.
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t buffer_size = 4 * 1024 * 1024; // uint64_t items per worker - 32 MB
+constexpr size_t chase_steps = 1 << 18;
+constexpr int tasks_count = 64;
+
+volatile uint64_t sink; // keeps the results observable
+
+struct WorkerBuffer
+{
+    vector<uint64_t> items;
+
+    WorkerBuffer()
+        : items(buffer_size)
+    {
+        // random permutation for pointer chasing - touched by the owning worker
+        iota(items.begin(), items.end(), 0);
+        shuffle(items.begin(), items.end(), mt19937_64{42});
+    }
+};
+
+WorkerBuffer& worker_buffer()
+{
+    thread_local WorkerBuffer buffer;
+    return buffer;
+}
+
+uint64_t stream_task()
+{
+    const auto& items = worker_buffer().items;
+    return accumulate(items.begin(), items.end(), uint64_t{});
+}
+
+uint64_t chase_task()
+{
+    const auto& items = worker_buffer().items;
+
+    uint64_t index = 0;
+    for (size_t i = 0; i < chase_steps; ++i)
+        index = items[index];
+
+    return index;
+}
+
+chrono::duration<double, milli> measure(size_t threads_count, WorkerPlacement placement)
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = threads_count, .max_threads = threads_count, .placement = placement}};
+
+    // warm up - every worker allocates its buffer
+    {
+        vector<Future<uint64_t>> f_results;
+        for (size_t i = 0; i < threads_count * 4; ++i)
+            f_results.push_back(pool.submit(stream_task));
+        for (auto& f : f_results)
+            f.get();
+    }
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    vector<Future<uint64_t>> f_results;
+    f_results.reserve(tasks_count);
+
+    for (int i = 0; i < tasks_count; ++i)
+        f_results.push_back(i % 2 == 0 ? pool.submit(stream_task) : pool.submit(chase_task));
+
+    for (auto& f : f_results)
+        sink = sink + f.get();
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return end - start;
+}
+
+string to_string(WorkerPlacement placement)
+{
+    switch (placement)
+    {
+    case WorkerPlacement::compact:
+        return "compact";
+    case WorkerPlacement::scatter:
+        return "scatter";
+    default:
+        return "unpinned";
+    }
+}
+
+int main()
+{
+    for (const auto& node : numa_nodes())
+        cout << "NUMA node " << node.id << ": " << node.cpus.size() << " cpus\n";
+
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << tasks_count << " tasks (streaming sum & pointer chasing over a 32 MB per-worker buffer)\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        for (auto placement : {WorkerPlacement::none, WorkerPlacement::compact, WorkerPlacement::scatter})
+        {
+            const auto elapsed = measure(threads_count, placement);
+
+            cout << left << setw(12) << to_string(placement)
+                 << "threads = " << setw(5) << threads_count
+                 << "time = " << fixed << setprecision(1) << elapsed.count() << "ms" << endl;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions - every form of operator new (scalar & array, aligned, nothrow)
+// increments allocations_count. Include in one translation unit of a benchmark only.
+
+inline std::atomic<size_t> allocations_count{};
+
+namespace AllocationCounter
+{
+    // not inlined into the replacement functions - GCC would pair the malloc()/free() calls
+    // with new/delete expressions and warn about mismatched allocation functions
+    [[gnu::noinline]] inline void* allocate(size_t size, size_t alignment) noexcept
+    {
+        allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+        if (size == 0)
+            size = 1;
+
+        if (alignment <= alignof(std::max_align_t))
+            return std::malloc(size);
+
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); // size must be a multiple of alignment
+    }
+
+    [[gnu::noinline]] inline void deallocate(void* ptr) noexcept
+    {
+        std::free(ptr);
+    }
+
+    inline void* allocate_or_throw(size_t size, size_t alignment)
+    {
+        if (void* ptr = allocate(size, alignment))
+            return ptr;
+
+        throw std::bad_alloc{};
+    }
+} // namespace AllocationCounter
+
+void* operator new(size_t size)
+{
+    return AllocationCounter::allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+    return AllocationCounter::allocate_or_throw(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return AllocationCounter::allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return AllocationCounter::allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocationCounter::allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocationCounter::allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocationCounter::allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocationCounter::allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    AllocationCounter::deallocate(ptr);
+}
+
+#endif // ALLOCATION_COUNTER_HPP
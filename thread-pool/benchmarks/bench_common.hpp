@@ -0,0 +1,20 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Worker counts every benchmark is run with - powers of two below max_threads, then max_threads itself
+inline std::vector<size_t> threads_counts_sweep(size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u))
+{
+    std::vector<size_t> threads_counts;
+    for (size_t n = 1; n < max_threads; n *= 2)
+        threads_counts.push_back(n);
+    threads_counts.push_back(max_threads);
+
+    return threads_counts;
+}
+
+#endif // BENCH_COMMON_HPP
@@ -0,0 +1,93 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * ThreadPool: looped submit vs. submit_bulk
+ * *****************************************************/
+
+using namespace std;
+
+constexpr int batch_size = 10'000;
+constexpr int batches_count = 50;
+
+struct Result
+{
+    chrono::duration<double, micro> submit_time{};
+    chrono::duration<double, micro> total_time{};
+};
+
+template <typename SubmitBatch>
+Result measure(size_t threads_count, SubmitBatch submit_batch)
+{
+    vector<int> items(batch_size);
+    iota(items.begin(), items.end(), 0);
+
+    Result result;
+    ThreadPool pool(threads_count);
+
+    for (int i = 0; i < batches_count; ++i)
+    {
+        const auto start = chrono::high_resolution_clock::now();
+
+        vector<Future<int>> f_results = submit_batch(pool, items);
+
+        const auto submitted = chrono::high_resolution_clock::now();
+
+        for (auto& f : f_results)
+            f.wait();
+
+        const auto end = chrono::high_resolution_clock::now();
+
+        result.submit_time += submitted - start;
+        result.total_time += end - start;
+    }
+
+    result.submit_time /= batches_count;
+    result.total_time /= batches_count;
+
+    return result;
+}
+
+void print_result(const string& name, size_t threads_count, const Result& result)
+{
+    cout << left << setw(16) << name
+         << "threads = " << setw(5) << threads_count
+         << "submit = " << setw(10) << fixed << setprecision(1) << result.submit_time.count() << "us   "
+         << "submit + run = " << result.total_time.count() << "us" << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << "Batch of " << batch_size << " tasks (average of " << batches_count << " batches)\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        auto looped = measure(threads_count, [](ThreadPool& pool, const vector<int>& items) {
+            vector<Future<int>> f_results;
+            f_results.reserve(items.size());
+
+            for (int item : items)
+                f_results.push_back(pool.submit([item] { return item * item; }));
+
+            return f_results;
+        });
+
+        auto bulk = measure(threads_count, [](ThreadPool& pool, const vector<int>& items) {
+            return pool.submit_bulk(items, [](int item) { return item * item; });
+        });
+
+        print_result("looped submit", threads_count, looped);
+        print_result("submit_bulk", threads_count, bulk);
+    }
+}
@@ -0,0 +1,108 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Chains of dependent steps: blocking get() vs. coroutines
+ *
+ * Every request runs steps_count steps one after another,
+ * every step is a small task executed by a pool worker.
+ * *****************************************************/
+
+using namespace std;
+
+constexpr int requests_count = 10'000;
+constexpr int steps_count = 20;
+
+int step(int value)
+{
+    return value * 3 % 1'000'003 + 1;
+}
+
+// today: a handler occupies a thread & blocks in get() while its step runs
+int blocking_handler(ThreadPool& steps_pool, int value)
+{
+    for (int i = 0; i < steps_count; ++i)
+        value = steps_pool.submit([value] { return step(value); }).get();
+
+    return value;
+}
+
+Coro::Task<int> async_step(ThreadPool& pool, int value)
+{
+    co_await pool.schedule();
+    co_return step(value);
+}
+
+Coro::Task<int> coroutine_handler(ThreadPool& pool, int value)
+{
+    for (int i = 0; i < steps_count; ++i)
+        value = co_await async_step(pool, value);
+
+    co_return value;
+}
+
+template <typename Function>
+chrono::duration<double, milli> measure(Function run_requests)
+{
+    const auto start = chrono::high_resolution_clock::now();
+    run_requests();
+    const auto end = chrono::high_resolution_clock::now();
+
+    return end - start;
+}
+
+void print_result(const string& name, size_t threads_count, chrono::duration<double, milli> elapsed)
+{
+    cout << left << setw(24) << name
+         << "threads = " << setw(5) << threads_count
+         << "time = " << setw(10) << fixed << setprecision(1) << elapsed.count() << "ms   "
+         << "steps/s = " << setprecision(0) << requests_count * steps_count / chrono::duration<double>(elapsed).count() << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << requests_count << " requests x " << steps_count << " dependent steps\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        // handlers & steps need separate pools - blocked handlers would starve their own steps
+        auto blocking = measure([threads_count] {
+            ThreadPool steps_pool(threads_count);
+            ThreadPool handlers_pool(threads_count);
+
+            vector<Future<int>> f_results;
+            f_results.reserve(requests_count);
+            for (int i = 0; i < requests_count; ++i)
+                f_results.push_back(handlers_pool.submit([&steps_pool, i] { return blocking_handler(steps_pool, i); }));
+
+            for (auto& f : f_results)
+                f.get();
+        });
+
+        // all requests are in flight at once - none of them holds a thread while waiting
+        auto coroutines = measure([threads_count] {
+            ThreadPool pool(threads_count);
+
+            vector<Future<int>> f_results;
+            f_results.reserve(requests_count);
+            for (int i = 0; i < requests_count; ++i)
+                f_results.push_back(Coro::spawn(pool, coroutine_handler(pool, i)));
+
+            for (auto& f : f_results)
+                f.get();
+        });
+
+        print_result("blocking get()", threads_count * 2, blocking);
+        print_result("coroutines", threads_count, coroutines);
+    }
+}
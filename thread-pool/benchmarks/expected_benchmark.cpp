@@ -0,0 +1,176 @@
+#include "bench_common.hpp"
+#include "expected.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Error path of submitted tasks at different failure rates:
+ * - std::packaged_task + std::future - throw, exception_ptr, rethrow
+ * - submit + Future - throw, exception_ptr, rethrow
+ * - try_submit + Expected - the error is returned as a value
+ * *****************************************************/
+
+using namespace std;
+
+constexpr int tasks_count = 200'000;
+constexpr int batch_size = 1'000; // futures collected per batch
+
+enum class SquareError
+{
+    unlucky_number
+};
+
+bool fails(int x, int fail_every)
+{
+    return fail_every != 0 && x % fail_every == 0;
+}
+
+int square_or_throw(int x, int fail_every)
+{
+    if (fails(x, fail_every))
+        throw runtime_error("Error#13");
+    return x * x;
+}
+
+Expected<int, SquareError> try_square(int x, int fail_every)
+{
+    if (fails(x, fail_every))
+        return Unexpected{SquareError::unlucky_number};
+    return x * x;
+}
+
+struct Result
+{
+    chrono::duration<double, nano> time_per_task;
+    int errors_count;
+};
+
+template <typename Submit, typename Collect>
+Result measure(Submit submit, Collect collect)
+{
+    int errors_count = 0;
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (int first = 0; first < tasks_count; first += batch_size)
+    {
+        auto futures = submit(first);
+        errors_count += collect(futures);
+    }
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return {(end - start) / tasks_count, errors_count};
+}
+
+Result packaged_tasks(ThreadPool& pool, int fail_every)
+{
+    return measure(
+        [&](int first) {
+            vector<future<int>> futures;
+            for (int i = first; i < first + batch_size; ++i)
+            {
+                packaged_task<int()> task{[i, fail_every] { return square_or_throw(i, fail_every); }};
+                futures.push_back(task.get_future());
+                pool.post(Task{std::move(task)});
+            }
+            return futures;
+        },
+        [](vector<future<int>>& futures) {
+            int errors_count = 0;
+            for (auto& f : futures)
+            {
+                try
+                {
+                    f.get();
+                }
+                catch (const runtime_error&)
+                {
+                    ++errors_count;
+                }
+            }
+            return errors_count;
+        });
+}
+
+Result futures(ThreadPool& pool, int fail_every)
+{
+    return measure(
+        [&](int first) {
+            vector<Future<int>> futures;
+            for (int i = first; i < first + batch_size; ++i)
+                futures.push_back(pool.submit([i, fail_every] { return square_or_throw(i, fail_every); }));
+            return futures;
+        },
+        [](vector<Future<int>>& futures) {
+            int errors_count = 0;
+            for (auto& f : futures)
+            {
+                try
+                {
+                    f.get();
+                }
+                catch (const runtime_error&)
+                {
+                    ++errors_count;
+                }
+            }
+            return errors_count;
+        });
+}
+
+Result expected_results(ThreadPool& pool, int fail_every)
+{
+    return measure(
+        [&](int first) {
+            vector<Future<Expected<int, SquareError>>> futures;
+            for (int i = first; i < first + batch_size; ++i)
+                futures.push_back(pool.try_submit([i, fail_every] { return try_square(i, fail_every); }));
+            return futures;
+        },
+        [](vector<Future<Expected<int, SquareError>>>& futures) {
+            int errors_count = 0;
+            for (auto& f : futures)
+            {
+                if (!f.get())
+                    ++errors_count;
+            }
+            return errors_count;
+        });
+}
+
+void print_result(const string& name, size_t threads_count, const Result& result)
+{
+    cout << left << setw(24) << name
+         << "threads = " << setw(5) << threads_count
+         << "time/task = " << setw(10) << fixed << setprecision(1) << result.time_per_task.count() << "ns   "
+         << "errors = " << result.errors_count << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    // 0 - no failures, 13 - every multiple of 13 fails (as calculate_square), 1 - every task fails
+    for (int fail_every : {0, 13, 2, 1})
+    {
+        cout << "\nfailing: " << (fail_every == 0 ? string{"none"} : "1 of " + to_string(fail_every)) << " (" << tasks_count << " tasks)\n";
+
+        for (auto threads_count : threads_counts)
+        {
+            ThreadPool pool(threads_count);
+            print_result("packaged_task + future", threads_count, packaged_tasks(pool, fail_every));
+            print_result("submit + Future", threads_count, futures(pool, fail_every));
+            print_result("try_submit + Expected", threads_count, expected_results(pool, fail_every));
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "bench_common.hpp"
+#include "histogram.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Submit-to-start latency of tiny tasks under bursty load:
+ * parking vs. spin-then-park idle strategies
+ * *****************************************************/
+
+using namespace std;
+
+constexpr int bursts_count = 2'000;
+constexpr int burst_size = 8;
+
+Log2Histogram measure(size_t threads_count, const IdleStrategy& idle_strategy)
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = threads_count, .max_threads = threads_count, .idle_strategy = idle_strategy}};
+
+    mt19937 rng{42};
+    uniform_int_distribution<int> gap_us(20, 500); // quiet period between bursts
+
+    vector<chrono::steady_clock::duration> latencies(bursts_count * burst_size);
+
+    for (int burst = 0; burst < bursts_count; ++burst)
+    {
+        vector<Future<void>> f_tasks;
+        f_tasks.reserve(burst_size);
+
+        for (int i = 0; i < burst_size; ++i)
+        {
+            auto& latency = latencies[burst * burst_size + i];
+            const auto submitted = chrono::steady_clock::now();
+            f_tasks.push_back(pool.submit([&latency, submitted] { latency = chrono::steady_clock::now() - submitted; }));
+        }
+
+        for (auto& f : f_tasks)
+            f.get();
+
+        const auto quiet_until = chrono::steady_clock::now() + chrono::microseconds(gap_us(rng));
+        while (chrono::steady_clock::now() < quiet_until)
+            this_thread::yield();
+    }
+
+    Log2Histogram histogram;
+    for (auto latency : latencies)
+        histogram.record(chrono::duration_cast<chrono::nanoseconds>(latency).count());
+
+    return histogram;
+}
+
+int main()
+{
+    using namespace std::literals;
+
+    const auto threads_counts = threads_counts_sweep();
+
+    const pair<string, IdleStrategy> strategies[] = {
+        {"park", IdleStrategy{}},
+        {"yield-park", IdleStrategy{.yield_count = 16}},
+        {"spin-park 20us", IdleStrategy{.max_spin_time = 20us}},
+        {"spin-yield-park", IdleStrategy{.max_spin_time = 200us, .yield_count = 16}},
+    };
+
+    cout << bursts_count << " bursts of " << burst_size << " tasks, 20-500us apart\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        for (const auto& [name, strategy] : strategies)
+        {
+            const auto latency = measure(threads_count, strategy);
+
+            cout << left << setw(18) << name
+                 << "threads = " << setw(5) << threads_count
+                 << "latency p50 = " << setw(10) << latency.percentile(0.5) << "ns   "
+                 << "p99 = " << setw(10) << latency.percentile(0.99) << "ns   "
+                 << "max = " << latency.max() << "ns" << endl;
+        }
+    }
+}
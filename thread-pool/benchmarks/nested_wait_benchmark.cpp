@@ -0,0 +1,86 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Recursive divide & conquer on a fixed-size pool:
+ * tasks wait (get()) for subtasks they submitted
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t items_count = 4'000'000;
+constexpr ptrdiff_t sequential_cutoff = 4'096;
+
+template <typename Pool>
+void parallel_quicksort(Pool& pool, vector<int>::iterator first, vector<int>::iterator last)
+{
+    if (last - first <= sequential_cutoff)
+    {
+        sort(first, last);
+        return;
+    }
+
+    const int pivot = *(first + (last - first) / 2);
+    const auto middle1 = partition(first, last, [pivot](int x) { return x < pivot; });
+    const auto middle2 = partition(middle1, last, [pivot](int x) { return !(pivot < x); });
+
+    auto f_left = pool.submit([&pool, first, middle1] { parallel_quicksort(pool, first, middle1); });
+    parallel_quicksort(pool, middle2, last);
+    f_left.get(); // waiting worker runs queued tasks meanwhile
+}
+
+template <typename Pool>
+chrono::duration<double, milli> measure(size_t threads_count, const vector<int>& input)
+{
+    Pool pool(threads_count);
+    auto data = input;
+
+    const auto start = chrono::high_resolution_clock::now();
+    pool.submit([&] { parallel_quicksort(pool, data.begin(), data.end()); }).get();
+    const auto end = chrono::high_resolution_clock::now();
+
+    if (!is_sorted(data.begin(), data.end()))
+        cout << "ERROR: not sorted" << endl;
+
+    return end - start;
+}
+
+void print_result(const string& name, size_t threads_count, chrono::duration<double, milli> time)
+{
+    cout << left << setw(16) << name
+         << "threads = " << setw(5) << threads_count
+         << "time = " << fixed << setprecision(1) << time.count() << "ms" << endl;
+}
+
+int main()
+{
+    mt19937 rng{42};
+    vector<int> input(items_count);
+    generate(input.begin(), input.end(), rng);
+
+    {
+        auto data = input;
+        const auto start = chrono::high_resolution_clock::now();
+        sort(data.begin(), data.end());
+        const auto end = chrono::high_resolution_clock::now();
+
+        print_result("std::sort", 1, end - start);
+    }
+
+    const auto threads_counts = threads_counts_sweep();
+
+    for (auto threads_count : threads_counts)
+    {
+        print_result("ThreadPool", threads_count, measure<ThreadPool>(threads_count, input));
+        print_result("WorkStealing", threads_count, measure<WorkStealing::ThreadPool>(threads_count, input));
+    }
+}
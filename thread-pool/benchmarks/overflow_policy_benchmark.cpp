@@ -0,0 +1,115 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Overload: producers submit faster than workers run tasks -
+ * unbounded queue vs. bounded queue with overflow policies
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t producers_count = 4;
+constexpr int tasks_per_producer = 50'000;
+constexpr size_t queue_capacity = 1'024;
+constexpr auto task_time = 2us;
+
+struct Result
+{
+    chrono::duration<double, milli> time;
+    size_t peak_depth;
+    int rejected;
+    int inlined;
+};
+
+Result measure(size_t threads_count, size_t capacity, OverflowPolicy policy)
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = threads_count, .max_threads = threads_count, .queue_capacity = capacity, .overflow_policy = policy}};
+
+    atomic<int> rejected{};
+    atomic<int> inlined{};
+    atomic<bool> producing{true};
+    size_t peak_depth = 0;
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    jthread sampler{[&] {
+        while (producing)
+        {
+            const auto lanes = pool.lane_stats();
+            peak_depth = max(peak_depth, accumulate(lanes.begin(), lanes.end(), size_t{}, [](size_t sum, const auto& lane) { return sum + lane.depth; }));
+            this_thread::sleep_for(100us);
+        }
+    }};
+
+    {
+        vector<jthread> producers;
+        for (size_t p = 0; p < producers_count; ++p)
+            producers.emplace_back([&] {
+                for (int i = 0; i < tasks_per_producer; ++i)
+                {
+                    try
+                    {
+                        pool.post([&inlined] {
+                            if (Executor::current() == nullptr)
+                                inlined.fetch_add(1, memory_order_relaxed);
+
+                            const auto until = chrono::steady_clock::now() + task_time;
+                            while (chrono::steady_clock::now() < until)
+                                cpu_relax();
+                        });
+                    }
+                    catch (const QueueFullError&)
+                    {
+                        rejected.fetch_add(1, memory_order_relaxed);
+                    }
+                }
+            });
+    }
+
+    producing = false;
+    sampler.join();
+    pool.shutdown();
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return {end - start, peak_depth, rejected.load(), inlined.load()};
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    const tuple<string, size_t, OverflowPolicy> variants[] = {
+        {"unbounded", PriorityTaskQueue::unbounded, OverflowPolicy::block},
+        {"block", queue_capacity, OverflowPolicy::block},
+        {"reject", queue_capacity, OverflowPolicy::reject},
+        {"run_inline", queue_capacity, OverflowPolicy::run_inline},
+    };
+
+    cout << producers_count << " producers x " << tasks_per_producer << " tasks, capacity = " << queue_capacity << "\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        for (const auto& [name, capacity, policy] : variants)
+        {
+            const auto result = measure(threads_count, capacity, policy);
+
+            cout << left << setw(12) << name
+                 << "threads = " << setw(5) << threads_count
+                 << "time = " << setw(10) << fixed << setprecision(1) << result.time.count() << "ms   "
+                 << "peak depth = " << setw(10) << result.peak_depth
+                 << "rejected = " << setw(10) << result.rejected
+                 << "inlined = " << result.inlined << endl;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#include "bench_common.hpp"
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if HAS_PAR_UNSEQ
+#include <execution>
+#endif
+
+/*******************************************************
+ * for_each / transform_reduce / inclusive_scan:
+ * sequential STL vs. par_unseq (if built with TBB) vs.
+ * ThreadPool with static & dynamic chunking
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t items_count = 10'000'000;
+constexpr int repeats_count = 5;
+
+volatile double sink; // keeps reductions from being optimized away
+
+// uniform cost per element
+void uniform_work(double& x)
+{
+    x = sqrt(x * 1.0001 + 1.0);
+}
+
+// every 64th element is 100x more expensive - static chunks get unbalanced
+void irregular_work(double& x)
+{
+    const int rounds = static_cast<uint64_t>(x) % 64 == 0 ? 100 : 1;
+    for (int i = 0; i < rounds; ++i)
+        x = sqrt(x * 1.0001 + 1.0);
+}
+
+template <typename Function>
+chrono::duration<double, milli> measure(Function f)
+{
+    auto best = chrono::duration<double, milli>::max();
+
+    for (int r = 0; r < repeats_count; ++r)
+    {
+        const auto start = chrono::high_resolution_clock::now();
+        f();
+        best = min<chrono::duration<double, milli>>(best, chrono::high_resolution_clock::now() - start);
+    }
+
+    return best;
+}
+
+void print_result(const string& algorithm, const string& variant, size_t threads_count, chrono::duration<double, milli> time)
+{
+    cout << left << setw(20) << algorithm << setw(12) << variant
+         << "threads = " << setw(5) << threads_count
+         << "time = " << fixed << setprecision(2) << time.count() << "ms" << endl;
+}
+
+int main()
+{
+    vector<double> input(items_count);
+    iota(input.begin(), input.end(), 0.0);
+    vector<double> data(items_count);
+    vector<double> output(items_count);
+
+    const auto reset = [&] { copy(input.begin(), input.end(), data.begin()); };
+    const auto square = [](double x) { return x * x; };
+
+    print_result("for_each", "seq", 1, measure([&] { reset(); for_each(data.begin(), data.end(), uniform_work); }));
+    print_result("for_each irregular", "seq", 1, measure([&] { reset(); for_each(data.begin(), data.end(), irregular_work); }));
+    print_result("transform_reduce", "seq", 1, measure([&] { sink = transform_reduce(input.begin(), input.end(), 0.0, plus<>{}, square); }));
+    print_result("inclusive_scan", "seq", 1, measure([&] { inclusive_scan(input.begin(), input.end(), output.begin()); }));
+
+    const size_t hardware_threads = max(thread::hardware_concurrency(), 1u);
+
+#if HAS_PAR_UNSEQ
+    using std::execution::par_unseq;
+
+    print_result("for_each", "par_unseq", hardware_threads, measure([&] { reset(); for_each(par_unseq, data.begin(), data.end(), uniform_work); }));
+    print_result("for_each irregular", "par_unseq", hardware_threads, measure([&] { reset(); for_each(par_unseq, data.begin(), data.end(), irregular_work); }));
+    print_result("transform_reduce", "par_unseq", hardware_threads, measure([&] { sink = transform_reduce(par_unseq, input.begin(), input.end(), 0.0, plus<>{}, square); }));
+    print_result("inclusive_scan", "par_unseq", hardware_threads, measure([&] { inclusive_scan(par_unseq, input.begin(), input.end(), output.begin()); }));
+#else
+    cout << "par_unseq: not built (requires TBB)\n";
+#endif
+
+    const auto threads_counts = threads_counts_sweep(hardware_threads);
+
+    const pair<string, Chunking> chunkings[] = {{"static", Chunking{Chunking::static_chunks}}, {"dynamic", Chunking{Chunking::dynamic_chunks}}};
+
+    for (auto threads_count : threads_counts)
+    {
+        ThreadPool pool(threads_count);
+
+        for (const auto& [name, chunking] : chunkings)
+        {
+            print_result("for_each", name, threads_count, measure([&] { reset(); parallel_for(pool, data.begin(), data.end(), uniform_work, chunking); }));
+            print_result("for_each irregular", name, threads_count, measure([&] { reset(); parallel_for(pool, data.begin(), data.end(), irregular_work, chunking); }));
+            print_result("transform_reduce", name, threads_count, measure([&] { sink = parallel_transform_reduce(pool, input.begin(), input.end(), 0.0, plus<>{}, square, chunking); }));
+            print_result("inclusive_scan", name, threads_count, measure([&] { parallel_inclusive_scan(pool, input.begin(), input.end(), output.begin(), plus<>{}, chunking); }));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Latency-critical requests sharing ThreadPool with batch work:
+ * single FIFO lane vs. priority lanes
+ * *****************************************************/
+
+using namespace std;
+using namespace std::literals;
+
+constexpr int batch_tasks_count = 4'000;
+constexpr int critical_tasks_count = 200;
+constexpr auto batch_task_duration = 200us;
+constexpr auto critical_tasks_interval = 1ms;
+
+using Clock = chrono::steady_clock;
+
+void busy_work(Clock::duration duration)
+{
+    const auto end = Clock::now() + duration;
+    while (Clock::now() < end)
+    {
+    }
+}
+
+void print_wait(const string& name, Clock::duration wait)
+{
+    cout << name << " = " << setw(10) << chrono::duration_cast<chrono::microseconds>(wait).count() << "us  ";
+}
+
+void print_lane_stats(const ThreadPool& pool)
+{
+    const char* lane_names[] = {"high", "normal", "low"};
+    const auto stats = pool.lane_stats();
+
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        cout << "  lane " << left << setw(8) << lane_names[i] << right
+             << "depth = " << setw(5) << stats[i].depth
+             << "  dequeued = " << setw(6) << stats[i].dequeued_count << "  ";
+        print_wait("mean", stats[i].mean_wait);
+        print_wait("p50", stats[i].p50_wait);
+        print_wait("p99", stats[i].p99_wait);
+        print_wait("max", stats[i].max_wait);
+        cout << "\n";
+    }
+}
+
+void run_scenario(const string& name, TaskPriority batch_priority, TaskPriority critical_priority)
+{
+    vector<Clock::duration> critical_waits;
+    mutex mtx_critical_waits;
+
+    {
+        ThreadPool pool(max(thread::hardware_concurrency(), 2u));
+
+        for (int i = 0; i < batch_tasks_count; ++i)
+            pool.submit([] { busy_work(batch_task_duration); }, batch_priority);
+
+        vector<Future<void>> f_critical;
+        for (int i = 0; i < critical_tasks_count; ++i)
+        {
+            const auto submitted_at = Clock::now();
+            f_critical.push_back(pool.submit([submitted_at, &critical_waits, &mtx_critical_waits] {
+                const auto wait = Clock::now() - submitted_at;
+                lock_guard lk{mtx_critical_waits};
+                critical_waits.push_back(wait);
+            }, critical_priority));
+
+            this_thread::sleep_for(critical_tasks_interval);
+        }
+
+        when_all(std::move(f_critical)).wait();
+
+        cout << name << "\n";
+        print_lane_stats(pool);
+    }
+
+    sort(critical_waits.begin(), critical_waits.end());
+
+    cout << "  critical requests: ";
+    print_wait("p50", critical_waits[critical_waits.size() / 2]);
+    print_wait("p99", critical_waits[critical_waits.size() * 99 / 100]);
+    print_wait("max", critical_waits.back());
+    cout << "\n";
+}
+
+int main()
+{
+    run_scenario("Single FIFO (everything normal)", TaskPriority::normal, TaskPriority::normal);
+
+    cout << "-------------\n";
+
+    run_scenario("Priority lanes (batch low, critical high)", TaskPriority::low, TaskPriority::high);
+}
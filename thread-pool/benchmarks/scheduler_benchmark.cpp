@@ -0,0 +1,246 @@
+#include "bench_common.hpp"
+#include "histogram.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*******************************************************
+ * Scheduler regression suite - every pool variant on:
+ *  - empty-task throughput
+ *  - submit-to-start latency (idle pool woken by bursts)
+ *  - fan-out/fan-in rounds
+ *  - mixed short/long tasks submitted at a steady rate (head-of-line blocking)
+ * Usage: scheduler_benchmark [--json] - with --json one JSON object per line
+ * *****************************************************/
+
+using namespace std;
+
+constexpr ptrdiff_t empty_tasks_count = 200'000;
+constexpr int latency_bursts_count = 2'000;
+constexpr int fan_out_rounds = 1'000;
+constexpr ptrdiff_t fan_out_width = 64;
+constexpr ptrdiff_t mixed_tasks_count = 10'000;
+constexpr ptrdiff_t mixed_long_every = 50; // every n-th task is long
+constexpr auto short_task_time = 2us;
+constexpr auto long_task_time = 500us;
+constexpr auto mixed_submit_interval = 25us; // per worker - about twice the average task time
+
+// pool variants have different submit APIs - benchmarks only post fire & forget tasks
+void post(PoisoningPill::ThreadPool& pool, Task task)
+{
+    pool.submit(std::move(task));
+}
+
+void post(Executor& executor, Task task)
+{
+    executor.post(std::move(task));
+}
+
+void spin_for(chrono::nanoseconds duration)
+{
+    const auto until = chrono::steady_clock::now() + duration;
+    while (chrono::steady_clock::now() < until)
+        cpu_relax();
+}
+
+uint64_t elapsed_ns(chrono::steady_clock::time_point since)
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - since).count();
+}
+
+struct Measurement
+{
+    string workload;
+    string pool_name;
+    size_t threads_count;
+    vector<pair<string, double>> values;
+};
+
+template <typename Pool>
+Measurement empty_task_throughput(Pool& pool)
+{
+    latch all_done{empty_tasks_count};
+
+    const auto start = chrono::steady_clock::now();
+
+    for (ptrdiff_t i = 0; i < empty_tasks_count; ++i)
+        post(pool, Task{[&all_done] { all_done.count_down(); }});
+
+    all_done.wait();
+
+    const auto seconds = elapsed_ns(start) / 1e9;
+
+    return {"empty", "", 0, {{"tasks_per_sec", empty_tasks_count / seconds}}};
+}
+
+template <typename Pool>
+Measurement submit_to_start_latency(Pool& pool, size_t threads_count)
+{
+    Log2Histogram latency;
+    vector<uint64_t> latencies(threads_count);
+
+    for (int burst = 0; burst < latency_bursts_count; ++burst)
+    {
+        latch all_started{static_cast<ptrdiff_t>(threads_count)};
+
+        for (size_t i = 0; i < threads_count; ++i)
+        {
+            const auto submitted = chrono::steady_clock::now();
+            post(pool, Task{[&latency = latencies[i], &all_started, submitted] {
+                latency = elapsed_ns(submitted);
+                all_started.count_down();
+            }});
+        }
+
+        all_started.wait();
+
+        for (auto ns : latencies)
+            latency.record(ns);
+
+        this_thread::sleep_for(50us); // workers go idle again
+    }
+
+    return {"latency", "", 0,
+        {{"p50_ns", latency.percentile(0.5)}, {"p90_ns", latency.percentile(0.9)},
+            {"p99_ns", latency.percentile(0.99)}, {"max_ns", latency.max()}}};
+}
+
+template <typename Pool>
+Measurement fan_out_fan_in(Pool& pool)
+{
+    atomic<uint64_t> sink{};
+
+    const auto start = chrono::steady_clock::now();
+
+    for (int round = 0; round < fan_out_rounds; ++round)
+    {
+        latch all_done{fan_out_width};
+
+        for (ptrdiff_t i = 0; i < fan_out_width; ++i)
+            post(pool, Task{[&all_done, &sink, i] {
+                uint64_t x = i;
+                for (int k = 0; k < 100; ++k)
+                    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+                sink.fetch_add(x, memory_order_relaxed);
+                all_done.count_down();
+            }});
+
+        all_done.wait();
+    }
+
+    const auto seconds = elapsed_ns(start) / 1e9;
+
+    return {"fan-out", "", 0, {{"rounds_per_sec", fan_out_rounds / seconds}}};
+}
+
+template <typename Pool>
+Measurement mixed_short_long(Pool& pool, size_t threads_count)
+{
+    Log2Histogram short_latency;
+    vector<uint64_t> latencies(mixed_tasks_count);
+    latch all_done{mixed_tasks_count};
+
+    const auto start = chrono::steady_clock::now();
+    auto next_submit = start;
+
+    for (ptrdiff_t i = 0; i < mixed_tasks_count; ++i)
+    {
+        while (chrono::steady_clock::now() < next_submit)
+            this_thread::yield();
+        next_submit += mixed_submit_interval / threads_count;
+
+        const auto submitted = chrono::steady_clock::now();
+        const chrono::nanoseconds work = i % mixed_long_every == 0 ? chrono::nanoseconds{long_task_time} : short_task_time;
+
+        post(pool, Task{[&latency = latencies[i], &all_done, submitted, work] {
+            latency = elapsed_ns(submitted);
+            spin_for(work);
+            all_done.count_down();
+        }});
+    }
+
+    all_done.wait();
+
+    const auto total_ms = elapsed_ns(start) / 1e6;
+
+    for (ptrdiff_t i = 0; i < mixed_tasks_count; ++i)
+    {
+        if (i % mixed_long_every != 0)
+            short_latency.record(latencies[i]);
+    }
+
+    return {"mixed", "", 0,
+        {{"total_ms", total_ms}, {"short_p50_ns", short_latency.percentile(0.5)}, {"short_p99_ns", short_latency.percentile(0.99)}}};
+}
+
+void print_text(const Measurement& m)
+{
+    cout << left << setw(10) << m.workload << setw(30) << m.pool_name
+         << "threads = " << setw(5) << m.threads_count;
+
+    for (const auto& [name, value] : m.values)
+        cout << name << " = " << setw(12) << fixed << setprecision(0) << value;
+
+    cout << endl;
+}
+
+void print_json(const Measurement& m)
+{
+    cout << R"({"workload": ")" << m.workload << R"(", "pool": ")" << m.pool_name
+         << R"(", "threads": )" << m.threads_count;
+
+    for (const auto& [name, value] : m.values)
+        cout << R"(, ")" << name << R"(": )" << fixed << setprecision(1) << value;
+
+    cout << "}" << endl;
+}
+
+using Report = function<void(const Measurement&)>;
+
+// every workload gets a fresh pool - no warm state carried over between workloads
+template <typename MakePool>
+void run_workloads(const string& pool_name, size_t threads_count, MakePool make_pool, const Report& report)
+{
+    auto run = [&](auto workload) {
+        auto pool = make_pool(threads_count);
+        auto m = workload(*pool);
+        m.pool_name = pool_name;
+        m.threads_count = threads_count;
+        report(m);
+    };
+
+    run([](auto& pool) { return empty_task_throughput(pool); });
+    run([threads_count](auto& pool) { return submit_to_start_latency(pool, threads_count); });
+    run([](auto& pool) { return fan_out_fan_in(pool); });
+    run([threads_count](auto& pool) { return mixed_short_long(pool, threads_count); });
+}
+
+int main(int argc, char* argv[])
+{
+    const bool json = argc > 1 && string_view{argv[1]} == "--json";
+    const Report report = json ? Report{print_json} : Report{print_text};
+
+    const auto threads_counts = threads_counts_sweep();
+
+    for (auto threads_count : threads_counts)
+    {
+        run_workloads("PoisoningPill::ThreadPool", threads_count, [](size_t n) { return make_unique<PoisoningPill::ThreadPool>(n); }, report);
+        run_workloads("ThreadPool", threads_count, [](size_t n) { return make_unique<ThreadPool>(n); }, report);
+        run_workloads("ThreadPool spin-yield-park", threads_count, [](size_t n) {
+            return make_unique<ThreadPool>(ThreadPoolOptions{.min_threads = n, .max_threads = n, .idle_strategy = {.max_spin_time = 50us, .yield_count = 16}});
+        }, report);
+        run_workloads("WorkStealing::ThreadPool", threads_count, [](size_t n) { return make_unique<WorkStealing::ThreadPool>(n); }, report);
+    }
+}
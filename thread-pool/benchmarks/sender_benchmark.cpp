@@ -0,0 +1,141 @@
+#include "allocation_counter.hpp"
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/*******************************************************
+ * Pipelines of continuations run repeatedly:
+ * - submit + Future::then chain vs. schedule() | then() chain in sync_wait()
+ * - submit_bulk vs. bulk() over a vector
+ * *****************************************************/
+
+using namespace std;
+
+constexpr int chain_runs_count = 20'000;
+constexpr int bulk_runs_count = 200;
+constexpr size_t bulk_shape = 100'000;
+
+struct Result
+{
+    chrono::duration<double, micro> time_per_run;
+    double allocations_per_run;
+};
+
+template <typename Run>
+Result measure(int runs_count, Run run)
+{
+    const auto allocations_before = allocations_count.load();
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (int r = 0; r < runs_count; ++r)
+        run(r);
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return {(end - start) / runs_count, static_cast<double>(allocations_count - allocations_before) / runs_count};
+}
+
+// 4 steps: start on the pool, then 3 continuations
+Result chain_futures(ThreadPool& pool)
+{
+    return measure(chain_runs_count, [&pool](int r) {
+        const int result = pool.submit([r] { return r; })
+                               .then([](int x) { return x + 1; })
+                               .then([](int x) { return x * 2; })
+                               .then([](int x) { return x - 1; })
+                               .get();
+        if (result != (r + 1) * 2 - 1)
+            abort();
+    });
+}
+
+Result chain_senders(ThreadPool& pool)
+{
+    auto scheduler = pool.get_scheduler();
+
+    return measure(chain_runs_count, [scheduler](int r) {
+        auto [result] = *Exec::sync_wait(scheduler.schedule()
+            | Exec::then([r] { return r; })
+            | Exec::then([](int x) { return x + 1; })
+            | Exec::then([](int x) { return x * 2; })
+            | Exec::then([](int x) { return x - 1; }));
+        if (result != (r + 1) * 2 - 1)
+            abort();
+    });
+}
+
+void work(vector<double>& values, size_t i)
+{
+    double x = static_cast<double>(i);
+    for (int k = 0; k < 20; ++k)
+        x = x * 0.5 + 1.0;
+    values[i] = x;
+}
+
+Result bulk_submit(ThreadPool& pool, vector<double>& values)
+{
+    const size_t chunks_count = max<size_t>(pool.size(), 1);
+
+    return measure(bulk_runs_count, [&](int) {
+        vector<size_t> chunks(chunks_count);
+        iota(chunks.begin(), chunks.end(), 0);
+
+        auto futures = pool.submit_bulk(chunks, [&values, chunks_count](size_t chunk) {
+            for (size_t i = bulk_shape * chunk / chunks_count; i < bulk_shape * (chunk + 1) / chunks_count; ++i)
+                work(values, i);
+        });
+
+        for (auto& f : futures)
+            f.get();
+    });
+}
+
+Result bulk_senders(ThreadPool& pool, vector<double>& values)
+{
+    auto scheduler = pool.get_scheduler();
+
+    return measure(bulk_runs_count, [&](int) {
+        Exec::sync_wait(scheduler.schedule() | Exec::bulk(bulk_shape, [&values](size_t i) { work(values, i); }));
+    });
+}
+
+void print_result(const string& name, size_t threads_count, const Result& result)
+{
+    cout << left << setw(20) << name
+         << "threads = " << setw(5) << threads_count
+         << "time/run = " << setw(10) << fixed << setprecision(2) << result.time_per_run.count() << "us   "
+         << "allocations/run = " << result.allocations_per_run << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    vector<double> values(bulk_shape);
+
+    cout << "4-step chain (average of " << chain_runs_count << " runs)\n";
+    for (auto threads_count : threads_counts)
+    {
+        ThreadPool pool(threads_count);
+        print_result("futures", threads_count, chain_futures(pool));
+        print_result("senders", threads_count, chain_senders(pool));
+    }
+
+    cout << "\nbulk over " << bulk_shape << " elements (average of " << bulk_runs_count << " runs)\n";
+    for (auto threads_count : threads_counts)
+    {
+        ThreadPool pool(threads_count);
+        print_result("submit_bulk", threads_count, bulk_submit(pool, values));
+        print_result("bulk", threads_count, bulk_senders(pool, values));
+    }
+}
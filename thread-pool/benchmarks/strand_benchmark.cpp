@@ -0,0 +1,116 @@
+#include "bench_common.hpp"
+#include "strand.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Per-entity ordered updates: tasks locking a mutex
+ * per entity vs. one strand per entity
+ * *****************************************************/
+
+using namespace std;
+
+constexpr ptrdiff_t updates_count = 200'000;
+constexpr auto update_time = 1us;
+
+struct Account
+{
+    mutex mtx;
+    uint64_t balance{};
+};
+
+void update(Account& account, uint64_t amount)
+{
+    const auto until = chrono::steady_clock::now() + update_time;
+    while (chrono::steady_clock::now() < until)
+        cpu_relax();
+
+    account.balance += amount;
+}
+
+vector<size_t> random_entities(size_t entities_count)
+{
+    mt19937 rng{42};
+    uniform_int_distribution<size_t> entity(0, entities_count - 1);
+
+    vector<size_t> result(updates_count);
+    generate(result.begin(), result.end(), [&] { return entity(rng); });
+
+    return result;
+}
+
+chrono::duration<double, milli> measure_mutex(size_t threads_count, size_t entities_count)
+{
+    ThreadPool pool(threads_count);
+    vector<Account> accounts(entities_count);
+    latch all_done{updates_count};
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (auto entity : random_entities(entities_count))
+        pool.post([&account = accounts[entity], &all_done] {
+            {
+                lock_guard lk{account.mtx};
+                update(account, 1);
+            }
+            all_done.count_down();
+        });
+
+    all_done.wait();
+
+    return chrono::high_resolution_clock::now() - start;
+}
+
+chrono::duration<double, milli> measure_strands(size_t threads_count, size_t entities_count)
+{
+    ThreadPool pool(threads_count);
+    vector<Account> accounts(entities_count);
+    vector<unique_ptr<Strand>> strands;
+    for (size_t i = 0; i < entities_count; ++i)
+        strands.push_back(make_unique<Strand>(pool));
+    latch all_done{updates_count};
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (auto entity : random_entities(entities_count))
+        strands[entity]->post([&account = accounts[entity], &all_done] {
+            update(account, 1);
+            all_done.count_down();
+        });
+
+    all_done.wait();
+
+    return chrono::high_resolution_clock::now() - start;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << updates_count << " updates of random entities\n";
+
+    for (size_t entities_count : {4, 1'024})
+    {
+        for (auto threads_count : threads_counts)
+        {
+            const auto mutex_time = measure_mutex(threads_count, entities_count);
+            const auto strands_time = measure_strands(threads_count, entities_count);
+
+            cout << "entities = " << setw(7) << left << entities_count
+                 << "threads = " << setw(5) << threads_count
+                 << "mutex = " << setw(10) << fixed << setprecision(1) << mutex_time.count() << "ms   "
+                 << "strands = " << strands_time.count() << "ms" << endl;
+        }
+    }
+}
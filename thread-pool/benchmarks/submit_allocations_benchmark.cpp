@@ -0,0 +1,119 @@
+#include "allocation_counter.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <queue>
+#include <string>
+
+/*******************************************************
+ * Heap allocations per submitted task:
+ * std::packaged_task + std::function vs. Task + Future
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t tasks_count = 1'000'000;
+
+// closure capturing a few words - typical for tasks submitted to a pool
+struct Args
+{
+    int* result;
+    int a;
+    int b;
+    int c;
+};
+
+void print_result(const string& name, size_t allocations, chrono::high_resolution_clock::duration elapsed)
+{
+    cout << left << setw(46) << name
+         << "allocations/task = " << setw(8) << fixed << setprecision(3) << static_cast<double>(allocations) / tasks_count
+         << "ns/task = " << setprecision(1) << chrono::duration<double, nano>(elapsed).count() / tasks_count << endl;
+}
+
+template <typename F>
+void measure(const string& name, F benchmark)
+{
+    const auto allocations_before = allocations_count.load();
+    const auto start = chrono::high_resolution_clock::now();
+
+    benchmark();
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    print_result(name, allocations_count.load() - allocations_before, end - start);
+}
+
+int main()
+{
+    int result = 0;
+    Args args{&result, 1, 2, 3};
+
+    measure("std::packaged_task + std::function", [&] {
+        std::queue<std::function<void()>> tasks;
+        std::queue<std::future<int>> results;
+
+        for (size_t i = 0; i < tasks_count; ++i)
+        {
+            auto f_wrapped = std::make_shared<std::packaged_task<int()>>([args] { return args.a + args.b + args.c; });
+            results.push(f_wrapped->get_future());
+            tasks.push([f_wrapped] { (*f_wrapped)(); });
+
+            tasks.front()();
+            tasks.pop();
+            *args.result += results.front().get();
+            results.pop();
+        }
+    });
+
+    measure("Task + Future (make_task)", [&] {
+        std::queue<Task> tasks;
+        std::queue<Future<int>> results;
+
+        for (size_t i = 0; i < tasks_count; ++i)
+        {
+            auto [task, f_result] = make_task([args] { return args.a + args.b + args.c; });
+            results.push(std::move(f_result));
+            tasks.push(std::move(task));
+
+            tasks.front()();
+            tasks.pop();
+            *args.result += results.front().get();
+            results.pop();
+        }
+    });
+
+    measure("Task (fire & forget, small buffer)", [&] {
+        std::queue<Task> tasks;
+
+        for (size_t i = 0; i < tasks_count; ++i)
+        {
+            tasks.push([args] { *args.result += args.a + args.b + args.c; });
+
+            tasks.front()();
+            tasks.pop();
+        }
+    });
+
+    cout << "-------------\n";
+
+    {
+        ThreadPool pool{1};
+        std::latch all_done{tasks_count};
+
+        measure("ThreadPool::submit (end to end)", [&] {
+            for (size_t i = 0; i < tasks_count; ++i)
+                pool.submit([args, &all_done] { all_done.count_down(); return args.a; });
+
+            all_done.wait();
+        });
+    }
+
+    cout << "Checksum: " << result << endl;
+}
@@ -0,0 +1,102 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Allocation-heavy load - every worker runs a root task that submits
+ * small tasks in batches & collects their futures:
+ * global allocator vs. per-worker task arenas.
+ * Tasks of one root are run by any worker - states released there
+ * go back through the arena's remote-free list.
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t tasks_per_root = 200'000;
+constexpr size_t batch_size = 64;
+constexpr int runs_count = 5;
+
+struct Payload // closure of a typical task - a few captured values
+{
+    array<uint64_t, 6> values;
+};
+
+uint64_t root_task(ThreadPool& pool, size_t root)
+{
+    uint64_t sum = 0;
+    vector<Future<uint64_t>> batch;
+    batch.reserve(batch_size);
+
+    for (size_t i = 0; i < tasks_per_root; ++i)
+    {
+        const Payload payload{{root, i, i + 1, i + 2, i + 3, i + 4}};
+        batch.push_back(pool.submit([payload] { return payload.values[0] + payload.values[1]; }));
+
+        if (batch.size() == batch_size)
+        {
+            for (auto& f : batch)
+                sum += f.get();
+            batch.clear();
+        }
+    }
+
+    for (auto& f : batch)
+        sum += f.get();
+
+    return sum;
+}
+
+chrono::duration<double, milli> measure(size_t threads_count, bool task_arenas)
+{
+    ThreadPool pool(ThreadPoolOptions{.min_threads = threads_count, .max_threads = threads_count, .task_arenas = task_arenas});
+
+    chrono::duration<double, milli> total{};
+    atomic<uint64_t> sink{};
+
+    for (int r = 0; r < runs_count; ++r)
+    {
+        const auto start = chrono::high_resolution_clock::now();
+
+        vector<Future<uint64_t>> roots;
+        for (size_t root = 0; root < threads_count; ++root)
+            roots.push_back(pool.submit([&pool, root] { return root_task(pool, root); }));
+
+        for (auto& f : roots)
+            sink += f.get();
+
+        total += chrono::high_resolution_clock::now() - start;
+    }
+
+    return total / runs_count;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << tasks_per_root << " tasks per worker, batches of " << batch_size << " (average of " << runs_count << " runs)\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        for (bool task_arenas : {false, true})
+        {
+            const auto time = measure(threads_count, task_arenas);
+            const auto tasks_per_sec = threads_count * tasks_per_root / (time.count() / 1000);
+
+            cout << left << setw(20) << (task_arenas ? "task arenas" : "global allocator")
+                 << "threads = " << setw(5) << threads_count
+                 << "time = " << setw(10) << fixed << setprecision(1) << time.count() << "ms   "
+                 << "tasks/s = " << setprecision(0) << tasks_per_sec << endl;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#include "allocation_counter.hpp"
+#include "bench_common.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Layered dependency graph run repeatedly:
+ * futures driven by hand (wait() for predecessors) vs. TaskGraph
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t layers_count = 50;
+constexpr size_t layer_width = 64;
+constexpr size_t fan_in = 3; // every node depends on that many nodes of the previous layer
+constexpr int runs_count = 100;
+
+// predecessors of node i in the layer below
+vector<size_t> predecessors(size_t layer, size_t i)
+{
+    vector<size_t> result;
+    if (layer == 0)
+        return result;
+
+    for (size_t k = 0; k < fan_in; ++k)
+        result.push_back((layer - 1) * layer_width + (i + k) % layer_width);
+
+    return result;
+}
+
+void work(atomic<uint64_t>& sink, size_t id)
+{
+    uint64_t x = id;
+    for (int i = 0; i < 200; ++i)
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    sink.fetch_add(x, memory_order_relaxed);
+}
+
+struct Result
+{
+    chrono::duration<double, micro> time_per_run;
+    double allocations_per_run;
+};
+
+Result measure_futures(size_t threads_count)
+{
+    ThreadPool pool(threads_count);
+    atomic<uint64_t> sink{};
+
+    const auto allocations_before = allocations_count.load();
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (int r = 0; r < runs_count; ++r)
+    {
+        // submitted in topological order - every task blocks until its predecessors are done
+        vector<Future<void>> f_nodes;
+        f_nodes.reserve(layers_count * layer_width);
+
+        for (size_t layer = 0; layer < layers_count; ++layer)
+        {
+            for (size_t i = 0; i < layer_width; ++i)
+            {
+                vector<Future<void>*> f_predecessors;
+                for (size_t p : predecessors(layer, i))
+                    f_predecessors.push_back(&f_nodes[p]);
+
+                const size_t id = layer * layer_width + i;
+                f_nodes.push_back(pool.submit([&sink, id, f_predecessors = std::move(f_predecessors)] {
+                    for (auto* f : f_predecessors)
+                        f->wait();
+                    work(sink, id);
+                }));
+            }
+        }
+
+        // get() would release a state other tasks may still be waiting on
+        for (auto& f : f_nodes)
+            f.wait();
+    }
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return {(end - start) / runs_count, static_cast<double>(allocations_count - allocations_before) / runs_count};
+}
+
+Result measure_task_graph(size_t threads_count)
+{
+    ThreadPool pool(threads_count);
+    atomic<uint64_t> sink{};
+
+    TaskGraph graph;
+    for (size_t layer = 0; layer < layers_count; ++layer)
+    {
+        for (size_t i = 0; i < layer_width; ++i)
+        {
+            const auto id = graph.emplace([&sink, id = layer * layer_width + i] { work(sink, id); });
+            for (size_t p : predecessors(layer, i))
+                graph.precede(p, id);
+        }
+    }
+
+    graph.run(pool); // validates the graph
+    graph.wait();
+
+    const auto allocations_before = allocations_count.load();
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (int r = 0; r < runs_count; ++r)
+    {
+        graph.run(pool);
+        graph.wait();
+    }
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    return {(end - start) / runs_count, static_cast<double>(allocations_count - allocations_before) / runs_count};
+}
+
+void print_result(const string& name, size_t threads_count, const Result& result)
+{
+    cout << left << setw(16) << name
+         << "threads = " << setw(5) << threads_count
+         << "time/run = " << setw(10) << fixed << setprecision(1) << result.time_per_run.count() << "us   "
+         << "allocations/run = " << result.allocations_per_run << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << layers_count << " layers x " << layer_width << " nodes, fan-in " << fan_in << " (average of " << runs_count << " runs)\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        print_result("futures", threads_count, measure_futures(threads_count));
+        print_result("TaskGraph", threads_count, measure_task_graph(threads_count));
+    }
+}
@@ -0,0 +1,119 @@
+#include "bench_common.hpp"
+#include "histogram.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Delayed tasks: sleeping pool tasks vs. timer wheel
+ * + insert/cancel cost with millions of pending timers
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t pending_timers_count = 2'000'000;
+constexpr int delayed_tasks_count = 200;
+constexpr auto delay = 20ms;
+
+struct Result
+{
+    chrono::duration<double, milli> total_time;
+    Log2Histogram lateness; // in us
+};
+
+template <typename SubmitDelayed>
+Result measure_delayed(size_t threads_count, SubmitDelayed submit_delayed)
+{
+    ThreadPool pool(threads_count);
+    Result result;
+
+    const auto start = chrono::steady_clock::now();
+
+    vector<Future<chrono::steady_clock::time_point>> f_results;
+    for (int i = 0; i < delayed_tasks_count; ++i)
+        f_results.push_back(submit_delayed(pool));
+
+    for (auto& f : f_results)
+    {
+        const auto lateness = f.get() - (start + delay);
+        result.lateness.record(max<int64_t>(0, chrono::duration_cast<chrono::microseconds>(lateness).count()));
+    }
+
+    result.total_time = chrono::steady_clock::now() - start;
+
+    return result;
+}
+
+void print_result(const string& name, size_t threads_count, const Result& result)
+{
+    cout << left << setw(16) << name
+         << "threads = " << setw(5) << threads_count
+         << "total = " << setw(10) << fixed << setprecision(1) << result.total_time.count() << "ms   "
+         << "lateness p50 = " << setw(10) << result.lateness.percentile(0.5) << "us   "
+         << "p99 = " << result.lateness.percentile(0.99) << "us" << endl;
+}
+
+void measure_insert_cancel()
+{
+    ThreadPool pool(1);
+    TimerService timers(pool);
+
+    mt19937_64 rng{42};
+    uniform_int_distribution<int> delay_ms(1'000, 3'600'000);
+
+    vector<TimerHandle> handles;
+    handles.reserve(pending_timers_count);
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < pending_timers_count; ++i)
+        handles.push_back(timers.post_after(chrono::milliseconds(delay_ms(rng)), Task{[] { }}));
+
+    const auto inserted = chrono::high_resolution_clock::now();
+
+    shuffle(handles.begin(), handles.end(), rng);
+
+    const auto cancel_start = chrono::high_resolution_clock::now();
+
+    for (auto& handle : handles)
+        handle.cancel();
+
+    const auto cancelled = chrono::high_resolution_clock::now();
+
+    cout << pending_timers_count << " pending timers (1s - 1h): "
+         << "insert = " << fixed << setprecision(1) << chrono::duration<double, nano>(inserted - start).count() / pending_timers_count << "ns   "
+         << "cancel = " << chrono::duration<double, nano>(cancelled - cancel_start).count() / pending_timers_count << "ns" << endl;
+}
+
+int main()
+{
+    measure_insert_cancel();
+
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << delayed_tasks_count << " tasks delayed by " << delay.count() << "ms\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        auto sleeping = measure_delayed(threads_count, [](ThreadPool& pool) {
+            return pool.submit([] {
+                this_thread::sleep_for(delay);
+                return chrono::steady_clock::now();
+            });
+        });
+
+        auto timers = measure_delayed(threads_count, [](ThreadPool& pool) {
+            return pool.submit_after(delay, [] { return chrono::steady_clock::now(); });
+        });
+
+        print_result("sleep_for", threads_count, sleeping);
+        print_result("submit_after", threads_count, timers);
+    }
+}
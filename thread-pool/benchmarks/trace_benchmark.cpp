@@ -0,0 +1,63 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Cost of tracing per task: tiny tasks with tracing off vs. on
+ * Usage: trace_benchmark [trace.json] - dumps the last traced run
+ * *****************************************************/
+
+using namespace std;
+
+constexpr ptrdiff_t tasks_count = 1'000'000;
+constexpr size_t trace_buffer_size = 64 * 1024;
+
+chrono::duration<double, nano> time_per_task(size_t threads_count, size_t buffer_size, const char* trace_path = nullptr)
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = threads_count, .max_threads = threads_count, .trace_buffer_size = buffer_size}};
+    latch all_done{tasks_count};
+
+    const auto start = chrono::high_resolution_clock::now();
+
+    for (ptrdiff_t i = 0; i < tasks_count; ++i)
+        pool.post([&all_done] { all_done.count_down(); });
+
+    all_done.wait();
+
+    const auto end = chrono::high_resolution_clock::now();
+
+    if (trace_path)
+    {
+        ofstream out{trace_path};
+        pool.dump_trace(out);
+    }
+
+    return (end - start) / tasks_count;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t max_threads = max(thread::hardware_concurrency(), 1u);
+
+    const auto threads_counts = threads_counts_sweep(max_threads);
+
+    for (auto threads_count : threads_counts)
+    {
+        const auto untraced = time_per_task(threads_count, 0);
+        const auto traced = time_per_task(threads_count, trace_buffer_size, argc > 1 && threads_count == max_threads ? argv[1] : nullptr);
+
+        cout << "threads = " << setw(5) << left << threads_count
+             << "untraced = " << setw(10) << fixed << setprecision(1) << untraced.count() << "ns/task   "
+             << "traced = " << setw(10) << traced.count() << "ns/task   "
+             << "overhead = " << (traced - untraced).count() << "ns/task" << endl;
+    }
+}
@@ -0,0 +1,98 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Tasks/sec: ThreadPool (single queue) vs. WorkStealing::ThreadPool
+ * *****************************************************/
+
+using namespace std;
+
+constexpr ptrdiff_t flat_tasks_count = 500'000;
+constexpr int spawn_depth = 17; // 2^18 - 1 tasks
+
+// all tasks are submitted from the main thread
+template <typename Pool>
+double flat_tasks_per_sec(size_t threads_count)
+{
+    latch all_done{flat_tasks_count};
+
+    const auto start = chrono::high_resolution_clock::now();
+    {
+        Pool pool(threads_count);
+
+        for (ptrdiff_t i = 0; i < flat_tasks_count; ++i)
+            pool.submit([&all_done] { all_done.count_down(); });
+
+        all_done.wait();
+    }
+    const auto end = chrono::high_resolution_clock::now();
+
+    return flat_tasks_count / chrono::duration<double>(end - start).count();
+}
+
+// every task spawns two subtasks - a binary tree of tasks submitted from the workers
+template <typename Pool>
+void spawn(Pool& pool, int depth, latch& all_done)
+{
+    if (depth > 0)
+    {
+        pool.submit([&pool, depth, &all_done] { spawn(pool, depth - 1, all_done); });
+        pool.submit([&pool, depth, &all_done] { spawn(pool, depth - 1, all_done); });
+    }
+
+    all_done.count_down();
+}
+
+template <typename Pool>
+double spawned_tasks_per_sec(size_t threads_count)
+{
+    constexpr ptrdiff_t tasks_count = (ptrdiff_t{1} << (spawn_depth + 1)) - 1;
+    latch all_done{tasks_count};
+
+    const auto start = chrono::high_resolution_clock::now();
+    {
+        Pool pool(threads_count);
+
+        pool.submit([&pool, &all_done] { spawn(pool, spawn_depth, all_done); });
+
+        all_done.wait();
+    }
+    const auto end = chrono::high_resolution_clock::now();
+
+    return tasks_count / chrono::duration<double>(end - start).count();
+}
+
+void print_result(const string& workload, const string& pool_name, size_t threads_count, double tasks_per_sec)
+{
+    cout << left << setw(10) << workload << setw(28) << pool_name
+         << "threads = " << setw(5) << threads_count
+         << "tasks/s = " << fixed << setprecision(0) << tasks_per_sec << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    for (auto threads_count : threads_counts)
+    {
+        print_result("flat", "ThreadPool", threads_count, flat_tasks_per_sec<ThreadPool>(threads_count));
+        print_result("flat", "WorkStealing::ThreadPool", threads_count, flat_tasks_per_sec<WorkStealing::ThreadPool>(threads_count));
+    }
+
+    cout << "-------------\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        print_result("spawn", "ThreadPool", threads_count, spawned_tasks_per_sec<ThreadPool>(threads_count));
+        print_result("spawn", "WorkStealing::ThreadPool", threads_count, spawned_tasks_per_sec<WorkStealing::ThreadPool>(threads_count));
+    }
+}
@@ -0,0 +1,129 @@
+#include "bench_common.hpp"
+#include "thread_pool.hpp"
+#include "worker_local.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************
+ * Monte Carlo pi split into many small tasks:
+ * - fresh mt19937_64 per task & a shared atomic counter
+ * - fresh mt19937_64 per task & per-task results reduced from futures
+ * - WorkerLocal RNG & WorkerLocal partial counts reduced by combine_all()
+ * *****************************************************/
+
+using namespace std;
+
+constexpr size_t tasks_count = 20'000;
+constexpr size_t samples_per_task = 2'000;
+
+uint64_t count_hits(mt19937_64& rnd_gen, size_t count)
+{
+    uniform_real_distribution<double> rnd(0, 1.0);
+
+    uint64_t hits = 0;
+    for (size_t n = 0; n < count; ++n)
+    {
+        const double x = rnd(rnd_gen);
+        const double y = rnd(rnd_gen);
+        if (x * x + y * y < 1)
+            ++hits;
+    }
+
+    return hits;
+}
+
+double to_pi(uint64_t hits)
+{
+    return static_cast<double>(hits) / (tasks_count * samples_per_task) * 4;
+}
+
+double fresh_rng_atomic(ThreadPool& pool)
+{
+    atomic<uint64_t> hits{};
+    vector<Future<void>> futures;
+    futures.reserve(tasks_count);
+
+    for (size_t i = 0; i < tasks_count; ++i)
+        futures.push_back(pool.submit([&hits, i] {
+            mt19937_64 rnd_gen(i);
+            hits.fetch_add(count_hits(rnd_gen, samples_per_task), memory_order_relaxed);
+        }));
+
+    for (auto& f : futures)
+        f.get();
+
+    return to_pi(hits);
+}
+
+double fresh_rng_futures(ThreadPool& pool)
+{
+    vector<Future<uint64_t>> futures;
+    futures.reserve(tasks_count);
+
+    for (size_t i = 0; i < tasks_count; ++i)
+        futures.push_back(pool.submit([i] {
+            mt19937_64 rnd_gen(i);
+            return count_hits(rnd_gen, samples_per_task);
+        }));
+
+    uint64_t hits = 0;
+    for (auto& f : futures)
+        hits += f.get();
+
+    return to_pi(hits);
+}
+
+double worker_local(ThreadPool& pool)
+{
+    WorkerLocal<mt19937_64> rnd_gens{pool, [](size_t slot) { return mt19937_64(slot); }};
+    WorkerLocal<uint64_t> hits{pool};
+
+    vector<Future<void>> futures;
+    futures.reserve(tasks_count);
+
+    for (size_t i = 0; i < tasks_count; ++i)
+        futures.push_back(pool.submit([&] { hits.local() += count_hits(rnd_gens.local(), samples_per_task); }));
+
+    for (auto& f : futures)
+        f.get();
+
+    return to_pi(hits.combine_all(uint64_t{}, plus<>{}));
+}
+
+void measure(const string& name, size_t threads_count, function<double(ThreadPool&)> run)
+{
+    ThreadPool pool(threads_count);
+
+    const auto start = chrono::high_resolution_clock::now();
+    const double pi = run(pool);
+    const auto end = chrono::high_resolution_clock::now();
+
+    cout << left << setw(20) << name
+         << "threads = " << setw(5) << threads_count
+         << "pi = " << setw(10) << fixed << setprecision(5) << pi
+         << "time = " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+}
+
+int main()
+{
+    const auto threads_counts = threads_counts_sweep();
+
+    cout << tasks_count << " tasks x " << samples_per_task << " samples\n";
+
+    for (auto threads_count : threads_counts)
+    {
+        measure("fresh RNG + atomic", threads_count, fresh_rng_atomic);
+        measure("fresh RNG + futures", threads_count, fresh_rng_futures);
+        measure("WorkerLocal", threads_count, worker_local);
+    }
+}
@@ -0,0 +1,341 @@
+#ifndef CORO_TASK_HPP
+#define CORO_TASK_HPP
+
+#include "executor.hpp"
+#include "future.hpp"
+#include "task.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Coroutines running on executors - Coro::Task<T> is a coroutine, ::Task is a plain callable
+namespace Coro
+{
+    template <typename T = void>
+    class Task;
+
+    // co_await schedule(executor) resumes the coroutine on the executor.
+    // If the resumption is dropped or rejected (e.g. ThreadPool::shutdown(cancel_pending)) the coroutine is resumed
+    // with std::future_error{broken_promise}.
+    class ScheduleAwaiter
+    {
+        Executor& executor_;
+        bool is_dropped_{};
+
+        class Resumer
+        {
+            std::coroutine_handle<> handle_;
+            bool* is_dropped_;
+
+        public:
+            Resumer(std::coroutine_handle<> handle, bool* is_dropped)
+                : handle_{handle}
+                , is_dropped_{is_dropped}
+            {
+            }
+
+            Resumer(Resumer&& other) noexcept
+                : handle_{std::exchange(other.handle_, {})}
+                , is_dropped_{other.is_dropped_}
+            {
+            }
+
+            Resumer& operator=(Resumer&&) = delete;
+
+            ~Resumer()
+            {
+                if (!handle_)
+                    return;
+
+                *is_dropped_ = true;
+                handle_.resume();
+            }
+
+            void operator()()
+            {
+                std::exchange(handle_, {}).resume();
+            }
+        };
+
+    public:
+        explicit ScheduleAwaiter(Executor& executor) noexcept
+            : executor_{executor}
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // the coroutine may already run on another thread when try_post() returns - this awaiter must not be touched
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            executor_.try_post(::Task{Resumer{handle, &is_dropped_}}); // a rejected resumer is dropped right here
+        }
+
+        void await_resume() const
+        {
+            if (is_dropped_)
+                throw std::future_error{std::future_errc::broken_promise};
+        }
+    };
+
+    inline ScheduleAwaiter schedule(Executor& executor) noexcept
+    {
+        return ScheduleAwaiter{executor};
+    }
+
+    namespace Detail
+    {
+        // transfers control to the awaiting coroutine - deep chains do not grow the stack
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                if (auto continuation = handle.promise().continuation_)
+                    return continuation;
+
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept { }
+        };
+
+        template <typename T>
+        class PromiseBase
+        {
+            using StoredType = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        protected:
+            std::variant<std::monostate, StoredType, std::exception_ptr> result_;
+
+        public:
+            std::coroutine_handle<> continuation_;
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() noexcept
+            {
+                result_.template emplace<2>(std::current_exception());
+            }
+
+            T get_result()
+            {
+                if (result_.index() == 2)
+                    std::rethrow_exception(std::get<2>(result_));
+
+                if constexpr (!std::is_void_v<T>)
+                    return std::move(std::get<1>(result_));
+            }
+        };
+
+        template <typename T>
+        struct TaskPromise : PromiseBase<T>
+        {
+            Task<T> get_return_object() noexcept;
+
+            template <typename U = T>
+            void return_value(U&& value)
+            {
+                this->result_.template emplace<1>(std::forward<U>(value));
+            }
+        };
+
+        template <>
+        struct TaskPromise<void> : PromiseBase<void>
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept
+            {
+                result_.template emplace<1>();
+            }
+        };
+    }
+
+    // Lazy coroutine - starts when awaited (co_await task runs it inline) or passed to spawn()/sync_wait()
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = Detail::TaskPromise<T>;
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        class Awaiter
+        {
+            std::coroutine_handle<promise_type> handle_;
+
+        public:
+            explicit Awaiter(std::coroutine_handle<promise_type> handle) noexcept
+                : handle_{handle}
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle_.promise().continuation_ = awaiting;
+                return handle_;
+            }
+
+            T await_resume()
+            {
+                return handle_.promise().get_result();
+            }
+        };
+
+    public:
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+            : handle_{handle}
+        {
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept
+            : handle_{std::exchange(other.handle_, {})}
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle_)
+                    handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+
+            return *this;
+        }
+
+        ~Task()
+        {
+            if (handle_)
+                handle_.destroy();
+        }
+
+        // a task can be awaited once
+        Awaiter operator co_await() && noexcept
+        {
+            return Awaiter{handle_};
+        }
+    };
+
+    template <typename T>
+    Task<T> Detail::TaskPromise<T>::get_return_object() noexcept
+    {
+        return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+    }
+
+    inline Task<void> Detail::TaskPromise<void>::get_return_object() noexcept
+    {
+        return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+    }
+
+    namespace Detail
+    {
+        // fire & forget coroutine - the frame is destroyed when it completes
+        struct Detached
+        {
+            struct promise_type
+            {
+                Detached get_return_object() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                void return_void() const noexcept { }
+
+                void unhandled_exception() const noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        template <typename T>
+        Detached run_detached(Executor* executor, Task<T> task, ::Promise<T> promise)
+        {
+            try
+            {
+                if (executor)
+                    co_await schedule(*executor);
+
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await std::move(task);
+                    promise.set_value();
+                }
+                else
+                    promise.set_value(co_await std::move(task));
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    // Starts the task on the executor - continuations of the returned future run there too
+    template <typename T>
+    Future<T> spawn(Executor& executor, Task<T> task)
+    {
+        ::Promise<T> promise{&executor};
+        auto f_result = promise.get_future();
+
+        Detail::run_detached(&executor, std::move(task), std::move(promise));
+
+        return f_result;
+    }
+
+    // Runs the task on the calling thread until it first suspends & blocks until it completes
+    template <typename T>
+    T sync_wait(Task<T> task)
+    {
+        ::Promise<T> promise;
+        auto f_result = promise.get_future();
+
+        Detail::run_detached(nullptr, std::move(task), std::move(promise));
+
+        return f_result.get();
+    }
+}
+
+#endif // CORO_TASK_HPP
@@ -0,0 +1,179 @@
+#ifndef CPU_TOPOLOGY_HPP
+#define CPU_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct NumaNode
+{
+    unsigned id;
+    std::vector<unsigned> cpus; // only cpus this process is allowed to run on
+};
+
+enum class WorkerPlacement
+{
+    none, // workers migrate freely
+    compact, // fill all cpus of a node before moving to the next one
+    scatter // round-robin workers over nodes
+};
+
+namespace Detail
+{
+    // parses a kernel cpu list, e.g. "0-3,8,10-11"
+    inline std::vector<unsigned> parse_cpu_list(std::string_view list)
+    {
+        std::vector<unsigned> cpus;
+
+        while (!list.empty())
+        {
+            const auto comma = list.find(',');
+            const auto range = list.substr(0, comma);
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+            unsigned first{}, last{};
+            auto [ptr, ec] = std::from_chars(range.data(), range.data() + range.size(), first);
+            if (ec != std::errc{})
+                continue;
+
+            last = first;
+            if (ptr != range.data() + range.size() && *ptr == '-')
+                std::from_chars(ptr + 1, range.data() + range.size(), last);
+
+            for (unsigned cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        return cpus;
+    }
+
+    inline std::vector<unsigned> allowed_cpus()
+    {
+        std::vector<unsigned> cpus;
+
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+        }
+#endif
+
+        return cpus;
+    }
+}
+
+// NUMA nodes discovered from sysfs - a single node with all allowed cpus if sysfs is not available
+inline std::vector<NumaNode> numa_nodes(const std::filesystem::path& sysfs_nodes = "/sys/devices/system/node")
+{
+    const auto allowed = Detail::allowed_cpus();
+    std::vector<NumaNode> nodes;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator{sysfs_nodes, ec})
+    {
+        const auto name = entry.path().filename().string();
+        unsigned id{};
+
+        if (!name.starts_with("node") || std::from_chars(name.data() + 4, name.data() + name.size(), id).ec != std::errc{})
+            continue;
+
+        std::ifstream in{entry.path() / "cpulist"};
+        std::string list;
+        std::getline(in, list);
+
+        NumaNode node{id, {}};
+        for (unsigned cpu : Detail::parse_cpu_list(list))
+            if (std::ranges::find(allowed, cpu) != allowed.end())
+                node.cpus.push_back(cpu);
+
+        if (!node.cpus.empty())
+            nodes.push_back(std::move(node));
+    }
+
+    std::ranges::sort(nodes, {}, &NumaNode::id);
+
+    if (nodes.empty() && !allowed.empty())
+        nodes.push_back(NumaNode{0, allowed});
+
+    return nodes;
+}
+
+struct CpuSlot
+{
+    unsigned cpu;
+    unsigned node;
+};
+
+// Maps worker slots to cpus - slots beyond the number of cpus wrap around
+class CpuPlacement
+{
+    std::vector<CpuSlot> slots_;
+
+public:
+    CpuPlacement() = default;
+
+    CpuPlacement(WorkerPlacement placement, const std::vector<NumaNode>& nodes)
+    {
+        if (placement == WorkerPlacement::compact)
+        {
+            for (const auto& node : nodes)
+                for (unsigned cpu : node.cpus)
+                    slots_.push_back(CpuSlot{cpu, node.id});
+        }
+        else if (placement == WorkerPlacement::scatter)
+        {
+            for (size_t i = 0; std::ranges::any_of(nodes, [i](const auto& n) { return i < n.cpus.size(); }); ++i)
+                for (const auto& node : nodes)
+                    if (i < node.cpus.size())
+                        slots_.push_back(CpuSlot{node.cpus[i], node.id});
+        }
+    }
+
+    bool empty() const
+    {
+        return slots_.empty();
+    }
+
+    CpuSlot operator[](size_t slot) const
+    {
+        return slots_[slot % slots_.size()];
+    }
+};
+
+// Pins the calling thread to the cpu & prefers its node for new pages - best effort, returns false on failure
+inline bool pin_current_thread(CpuSlot slot)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(slot.cpu, &set);
+    const bool is_pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+
+    // set_mempolicy(MPOL_PREFERRED) - called directly, so libnuma is not required
+    constexpr int mpol_preferred = 1;
+    constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(slot.node / bits_per_word + 1);
+    node_mask[slot.node / bits_per_word] = 1UL << (slot.node % bits_per_word);
+    const bool is_bound = syscall(SYS_set_mempolicy, mpol_preferred, node_mask.data(), node_mask.size() * bits_per_word + 1) == 0;
+
+    return is_pinned && is_bound;
+#else
+    return false;
+#endif
+}
+
+#endif // CPU_TOPOLOGY_HPP
@@ -0,0 +1,60 @@
+#ifndef EVENT_COUNT_HPP
+#define EVENT_COUNT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// Parks consumers until new work may exist - a producer touches shared state only if a consumer waits.
+//   consumer: epoch = prepare_wait(); re-check for work; then cancel_wait() or commit_wait(epoch)
+//   producer: publish work; notify_one()
+class EventCount
+{
+    std::atomic<uint32_t> epoch_{};
+    std::atomic<uint32_t> waiters_{};
+
+public:
+    uint32_t epoch() const noexcept
+    {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    uint32_t prepare_wait() noexcept
+    {
+        waiters_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the fence in notify_one()
+
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    void cancel_wait() noexcept
+    {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // returns at once if a notify came after prepare_wait()
+    void commit_wait(uint32_t epoch) noexcept
+    {
+        epoch_.wait(epoch, std::memory_order_acquire);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // the published work or the waiter is seen
+
+        if (waiters_.load(std::memory_order_relaxed) == 0)
+            return;
+
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_one();
+    }
+
+    // always advances the epoch - also wakes consumers that are about to wait (e.g. for a stop request)
+    void notify_all() noexcept
+    {
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_all();
+    }
+};
+
+#endif // EVENT_COUNT_HPP
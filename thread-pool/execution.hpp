@@ -0,0 +1,568 @@
+#ifndef EXECUTION_HPP
+#define EXECUTION_HPP
+
+#include "executor.hpp"
+#include "task.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Subset of P2300 (std::execution) senders & receivers - no dependency on a std::execution implementation.
+// - a sender has value_type (void or a single value) & connect(receiver) returning an immovable operation state
+// - a receiver has set_value(values...), set_error(std::exception_ptr) & set_stopped() - exactly one of them is called
+// - operation states are composed by value, so a pipeline connected in sync_wait() lives on the stack
+//   and needs no heap allocation per step (posting to the pool uses Task's small buffer)
+namespace Exec
+{
+    namespace Detail
+    {
+        // value_type of a sender as a set_value argument list
+        template <typename T>
+        struct ValueStorage
+        {
+            std::optional<T> value;
+
+            template <typename Receiver>
+            void set_value_to(Receiver& receiver)
+            {
+                receiver.set_value(std::move(*value));
+            }
+        };
+
+        template <>
+        struct ValueStorage<void>
+        {
+            template <typename Receiver>
+            void set_value_to(Receiver& receiver)
+            {
+                receiver.set_value();
+            }
+        };
+    } // namespace Detail
+
+    template <typename Sender, typename Receiver>
+    using connect_result_t = decltype(std::declval<Sender>().connect(std::declval<Receiver>()));
+
+    // Completes on a worker of the pool - with set_stopped() if the pool drops or rejects the task
+    // (e.g. shutdown(cancel_pending))
+    template <typename Pool, typename Receiver>
+    class ScheduleOperation
+    {
+        Pool* pool_;
+        Receiver receiver_;
+
+        class Runner
+        {
+            ScheduleOperation* op_;
+
+        public:
+            explicit Runner(ScheduleOperation* op) noexcept
+                : op_{op}
+            {
+            }
+
+            Runner(Runner&& other) noexcept
+                : op_{std::exchange(other.op_, nullptr)}
+            {
+            }
+
+            Runner& operator=(Runner&&) = delete;
+
+            ~Runner()
+            {
+                if (op_) // dropped or rejected by the pool
+                    op_->receiver_.set_stopped();
+            }
+
+            void operator()()
+            {
+                std::exchange(op_, nullptr)->receiver_.set_value();
+            }
+        };
+
+    public:
+        ScheduleOperation(Pool* pool, Receiver receiver)
+            : pool_{pool}
+            , receiver_{std::move(receiver)}
+        {
+        }
+
+        ScheduleOperation(const ScheduleOperation&) = delete;
+        ScheduleOperation& operator=(const ScheduleOperation&) = delete;
+
+        void start() noexcept
+        {
+            pool_->try_post(Task{Runner{this}}); // a rejected runner is dropped right here
+        }
+    };
+
+    template <typename Pool>
+    class Scheduler;
+
+    template <typename Pool>
+    class ScheduleSender
+    {
+        Pool* pool_;
+
+    public:
+        using value_type = void;
+
+        explicit ScheduleSender(Pool* pool) noexcept
+            : pool_{pool}
+        {
+        }
+
+        Scheduler<Pool> scheduler() const noexcept
+        {
+            return Scheduler<Pool>{*pool_};
+        }
+
+        template <typename Receiver>
+        ScheduleOperation<Pool, Receiver> connect(Receiver receiver) const
+        {
+            return {pool_, std::move(receiver)};
+        }
+    };
+
+    // Lightweight handle to a pool - Pool needs try_post(Task&&) & size()
+    template <typename Pool>
+    class Scheduler
+    {
+        Pool* pool_;
+
+    public:
+        explicit Scheduler(Pool& pool) noexcept
+            : pool_{&pool}
+        {
+        }
+
+        ScheduleSender<Pool> schedule() const noexcept
+        {
+            return ScheduleSender<Pool>{pool_};
+        }
+
+        Pool& pool() const noexcept
+        {
+            return *pool_;
+        }
+
+        bool operator==(const Scheduler&) const = default;
+    };
+
+    // then(sender, f) - f is called with the sender's value, its result (or exception) is sent on
+    template <typename Receiver, typename Function>
+    class ThenReceiver
+    {
+        Receiver receiver_;
+        Function f_;
+
+    public:
+        ThenReceiver(Receiver receiver, Function f)
+            : receiver_{std::move(receiver)}
+            , f_{std::move(f)}
+        {
+        }
+
+        template <typename... Values>
+        void set_value(Values&&... values) noexcept
+        {
+            using Result = std::invoke_result_t<Function&, Values...>;
+
+            if constexpr (std::is_void_v<Result>)
+            {
+                try
+                {
+                    std::invoke(f_, std::forward<Values>(values)...);
+                }
+                catch (...)
+                {
+                    receiver_.set_error(std::current_exception());
+                    return;
+                }
+
+                receiver_.set_value();
+            }
+            else
+            {
+                std::optional<Result> result;
+
+                try
+                {
+                    result.emplace(std::invoke(f_, std::forward<Values>(values)...));
+                }
+                catch (...)
+                {
+                    receiver_.set_error(std::current_exception());
+                    return;
+                }
+
+                receiver_.set_value(std::move(*result));
+            }
+        }
+
+        void set_error(std::exception_ptr error) noexcept
+        {
+            receiver_.set_error(std::move(error));
+        }
+
+        void set_stopped() noexcept
+        {
+            receiver_.set_stopped();
+        }
+    };
+
+    template <typename Sender, typename Function>
+    class ThenSender
+    {
+        template <typename T>
+        struct Result
+        {
+            using type = std::invoke_result_t<Function&, T>;
+        };
+
+        template <std::same_as<void> T>
+        struct Result<T>
+        {
+            using type = std::invoke_result_t<Function&>;
+        };
+
+        Sender sender_;
+        Function f_;
+
+    public:
+        using value_type = typename Result<typename Sender::value_type>::type;
+
+        ThenSender(Sender sender, Function f)
+            : sender_{std::move(sender)}
+            , f_{std::move(f)}
+        {
+        }
+
+        auto scheduler() const noexcept
+        {
+            return sender_.scheduler();
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver receiver) &&
+        {
+            return std::move(sender_).connect(ThenReceiver<Receiver, Function>{std::move(receiver), std::move(f_)});
+        }
+    };
+
+    template <typename Sender, typename Function>
+    ThenSender<std::remove_cvref_t<Sender>, std::decay_t<Function>> then(Sender&& sender, Function&& f)
+    {
+        return {std::forward<Sender>(sender), std::forward<Function>(f)};
+    }
+
+    // bulk(sender, shape, f) - f(i, value&) (or f(i) for void senders) for every i in [0, shape) spread over the workers
+    // of the sender's pool, then the value is sent on. The first exception thrown by f is sent to set_error().
+    template <typename Sender, std::integral Shape, typename Function, typename Receiver>
+    class BulkOperation
+    {
+        using Value = typename Sender::value_type;
+        using Pool = std::remove_reference_t<decltype(std::declval<Sender&>().scheduler().pool())>;
+
+        class InnerReceiver
+        {
+            BulkOperation* op_;
+
+        public:
+            explicit InnerReceiver(BulkOperation* op) noexcept
+                : op_{op}
+            {
+            }
+
+            template <typename... Values>
+            void set_value(Values&&... values) noexcept
+            {
+                if constexpr (!std::is_void_v<Value>)
+                    op_->value_.value.emplace(std::forward<Values>(values)...);
+                op_->start_bulk();
+            }
+
+            void set_error(std::exception_ptr error) noexcept
+            {
+                op_->receiver_.set_error(std::move(error));
+            }
+
+            void set_stopped() noexcept
+            {
+                op_->receiver_.set_stopped();
+            }
+        };
+
+        // every posted helper counts as a participant - the operation completes when the last one leaves
+        class Helper
+        {
+            BulkOperation* op_;
+
+        public:
+            explicit Helper(BulkOperation* op) noexcept
+                : op_{op}
+            {
+            }
+
+            Helper(Helper&& other) noexcept
+                : op_{std::exchange(other.op_, nullptr)}
+            {
+            }
+
+            Helper& operator=(Helper&&) = delete;
+
+            ~Helper()
+            {
+                if (op_) // dropped or rejected by the pool - other participants run its chunks
+                    op_->leave();
+            }
+
+            void operator()()
+            {
+                std::exchange(op_, nullptr)->participate();
+            }
+        };
+
+        Pool* pool_;
+        Shape shape_;
+        Function f_;
+        Receiver receiver_;
+        Detail::ValueStorage<Value> value_;
+        size_t chunks_count_{};
+        std::atomic<size_t> next_chunk_{};
+        std::atomic<size_t> participants_{};
+        std::atomic<bool> has_failed_{};
+        std::exception_ptr error_;
+        connect_result_t<Sender, InnerReceiver> inner_op_;
+
+        void run_chunk(size_t index)
+        {
+            const auto shape = static_cast<size_t>(shape_);
+            const size_t begin = shape * index / chunks_count_;
+            const size_t end = shape * (index + 1) / chunks_count_;
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                if constexpr (std::is_void_v<Value>)
+                    std::invoke(f_, static_cast<Shape>(i));
+                else
+                    std::invoke(f_, static_cast<Shape>(i), *value_.value);
+            }
+        }
+
+        void participate() noexcept
+        {
+            for (size_t index; (index = next_chunk_.fetch_add(1, std::memory_order_relaxed)) < chunks_count_;)
+            {
+                if (has_failed_.load(std::memory_order_relaxed))
+                    continue;
+
+                try
+                {
+                    run_chunk(index);
+                }
+                catch (...)
+                {
+                    if (!has_failed_.exchange(true))
+                        error_ = std::current_exception();
+                }
+            }
+
+            leave();
+        }
+
+        void leave() noexcept
+        {
+            if (participants_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (error_)
+                receiver_.set_error(std::move(error_));
+            else
+                value_.set_value_to(receiver_);
+        }
+
+        // runs on the thread that completed the predecessor - it participates together with up to size() - 1 helpers
+        void start_bulk() noexcept
+        {
+            const auto shape = static_cast<size_t>(std::max<Shape>(shape_, 0));
+            chunks_count_ = std::min(shape, std::max<size_t>(pool_->size(), 1));
+
+            const size_t helpers_count = chunks_count_ > 1 ? chunks_count_ - 1 : 0;
+            participants_.store(helpers_count + 1, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < helpers_count; ++i)
+            {
+                if (pool_->try_post(Task{Helper{this}})) // the rejected helper has left
+                {
+                    participants_.fetch_sub(helpers_count - i - 1, std::memory_order_relaxed); // the rest is not posted
+                    break;
+                }
+            }
+
+            participate();
+        }
+
+    public:
+        BulkOperation(Sender&& sender, Shape shape, Function f, Receiver receiver)
+            : pool_{&sender.scheduler().pool()}
+            , shape_{shape}
+            , f_{std::move(f)}
+            , receiver_{std::move(receiver)}
+            , inner_op_{std::move(sender).connect(InnerReceiver{this})}
+        {
+        }
+
+        BulkOperation(const BulkOperation&) = delete;
+        BulkOperation& operator=(const BulkOperation&) = delete;
+
+        void start() noexcept
+        {
+            inner_op_.start();
+        }
+    };
+
+    template <typename Sender, std::integral Shape, typename Function>
+    class BulkSender
+    {
+        Sender sender_;
+        Shape shape_;
+        Function f_;
+
+    public:
+        using value_type = typename Sender::value_type;
+
+        BulkSender(Sender sender, Shape shape, Function f)
+            : sender_{std::move(sender)}
+            , shape_{shape}
+            , f_{std::move(f)}
+        {
+        }
+
+        auto scheduler() const noexcept
+        {
+            return sender_.scheduler();
+        }
+
+        template <typename Receiver>
+        BulkOperation<Sender, Shape, Function, Receiver> connect(Receiver receiver) &&
+        {
+            return {std::move(sender_), shape_, std::move(f_), std::move(receiver)};
+        }
+    };
+
+    // the sender must complete on a pool - scheduler() tells which one
+    template <typename Sender, std::integral Shape, typename Function>
+    BulkSender<std::remove_cvref_t<Sender>, Shape, std::decay_t<Function>> bulk(Sender&& sender, Shape shape, Function&& f)
+    {
+        return {std::forward<Sender>(sender), shape, std::forward<Function>(f)};
+    }
+
+    // pipe syntax: scheduler.schedule() | then(f) | bulk(n, g)
+    template <typename Function>
+    struct ThenClosure
+    {
+        Function f;
+    };
+
+    template <std::integral Shape, typename Function>
+    struct BulkClosure
+    {
+        Shape shape;
+        Function f;
+    };
+
+    template <typename Function>
+    ThenClosure<std::decay_t<Function>> then(Function&& f)
+    {
+        return {std::forward<Function>(f)};
+    }
+
+    template <std::integral Shape, typename Function>
+    BulkClosure<Shape, std::decay_t<Function>> bulk(Shape shape, Function&& f)
+    {
+        return {shape, std::forward<Function>(f)};
+    }
+
+    template <typename Sender, typename Function>
+    auto operator|(Sender&& sender, ThenClosure<Function> closure)
+    {
+        return then(std::forward<Sender>(sender), std::move(closure.f));
+    }
+
+    template <typename Sender, typename Shape, typename Function>
+    auto operator|(Sender&& sender, BulkClosure<Shape, Function> closure)
+    {
+        return bulk(std::forward<Sender>(sender), closure.shape, std::move(closure.f));
+    }
+
+    namespace Detail
+    {
+        template <typename Result>
+        struct SyncWaitState
+        {
+            ::Detail::CompletionFlag done;
+            std::optional<Result> result;
+            std::exception_ptr error;
+
+            void finish() noexcept
+            {
+                done.set();
+            }
+        };
+
+        template <typename Result>
+        struct SyncWaitReceiver
+        {
+            SyncWaitState<Result>* state;
+
+            template <typename... Values>
+            void set_value(Values&&... values) noexcept
+            {
+                state->result.emplace(std::forward<Values>(values)...);
+                state->finish();
+            }
+
+            void set_error(std::exception_ptr error) noexcept
+            {
+                state->error = std::move(error);
+                state->finish();
+            }
+
+            void set_stopped() noexcept
+            {
+                state->finish();
+            }
+        };
+    } // namespace Detail
+
+    // Starts the sender & blocks until it completes - the operation state lives in this frame.
+    // Returns std::nullopt if the sender was stopped, rethrows an error.
+    // On a pool's worker other pending tasks are run meanwhile (as in Future::wait()).
+    template <typename Sender>
+    auto sync_wait(Sender&& sender)
+    {
+        using Value = typename std::remove_cvref_t<Sender>::value_type;
+        using Result = std::conditional_t<std::is_void_v<Value>, std::tuple<>, std::tuple<Value>>;
+
+        Detail::SyncWaitState<Result> state;
+        auto op = std::forward<Sender>(sender).connect(Detail::SyncWaitReceiver<Result>{&state});
+        op.start();
+        state.done.wait();
+
+        if (state.error)
+            std::rethrow_exception(state.error);
+
+        return std::move(state.result);
+    }
+} // namespace Exec
+
+#endif // EXECUTION_HPP
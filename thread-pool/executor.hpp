@@ -0,0 +1,168 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "task.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Anything that can run a Task asynchronously - used to schedule continuations
+class Executor
+{
+    inline static thread_local Executor* current_ = nullptr;
+
+protected:
+    // called by a worker thread before it starts running the executor's tasks
+    static void set_current(Executor* executor) noexcept
+    {
+        current_ = executor;
+    }
+
+    // advanced by wake_helpers()
+    virtual uint64_t wake_epoch() const noexcept
+    {
+        return 0;
+    }
+
+    // Runs one pending task on the calling worker - or parks until a task is queued
+    // or wake_helpers() moves the wake epoch past epoch.
+    virtual void run_pending_task(uint64_t /*epoch*/)
+    {
+        std::this_thread::yield();
+    }
+
+public:
+    virtual ~Executor() = default;
+
+    // throws if the executor rejects the task - the task is left untouched then
+    virtual void post(Task&& task) = 0;
+
+    // Returns an empty Task if the executor accepted the task - the task itself if it was rejected
+    // (e.g. after shutdown). A returned task that is dropped behaves like a task dropped by the executor.
+    virtual Task try_post(Task&& task) = 0;
+
+    // Runs pending tasks on the calling thread (one of the executor's workers) until is_done().
+    // The side that makes is_done() true must call wake_helpers() afterwards - Detail::CompletionFlag does.
+    template <typename Predicate>
+    void help_until(Predicate is_done)
+    {
+        while (true)
+        {
+            const uint64_t epoch = wake_epoch(); // read before the check - a wake-up in between is not lost
+
+            if (is_done())
+                return;
+
+            run_pending_task(epoch);
+        }
+    }
+
+    // wakes the workers parked in help_until() to re-check their predicates
+    virtual void wake_helpers()
+    {
+    }
+
+    // executor whose worker is the calling thread - nullptr outside of workers
+    static Executor* current() noexcept
+    {
+        return current_;
+    }
+};
+
+namespace Detail
+{
+    // One-shot event - a waiting worker runs its executor's pending tasks meanwhile (help_until),
+    // other threads block. The owner may keep own flags in the status word (from first_user_flag up).
+    class CompletionFlag
+    {
+        static constexpr unsigned has_helper = 2; // a worker of helper_ waits in help_until()
+        static constexpr unsigned helper_woken = 4; // set() does not touch helper_ any more
+
+        std::atomic<unsigned> status_;
+        std::atomic<Executor*> helper_{};
+
+        void wait_for(unsigned flag) const noexcept
+        {
+            auto status = status_.load(std::memory_order_acquire);
+
+            while (!(status & flag))
+            {
+                status_.wait(status, std::memory_order_acquire);
+                status = status_.load(std::memory_order_acquire);
+            }
+        }
+
+    public:
+        static constexpr unsigned done = 1;
+        static constexpr unsigned first_user_flag = 8;
+
+        explicit CompletionFlag(bool is_done = false) noexcept
+            : status_{is_done ? done : 0u}
+        {
+        }
+
+        CompletionFlag(const CompletionFlag&) = delete;
+        CompletionFlag& operator=(const CompletionFlag&) = delete;
+
+        bool is_done() const noexcept
+        {
+            return status_.load(std::memory_order_acquire) & done;
+        }
+
+        // sets done together with flags - returns the previous status
+        unsigned set(unsigned flags = 0)
+        {
+            const auto previous_status = status_.fetch_or(done | flags, std::memory_order_acq_rel);
+
+            if (previous_status & has_helper)
+            {
+                helper_.load(std::memory_order_relaxed)->wake_helpers();
+                status_.fetch_or(helper_woken, std::memory_order_release);
+            }
+
+            status_.notify_all();
+
+            return previous_status;
+        }
+
+        // returns the previous status
+        unsigned fetch_or(unsigned flags) noexcept
+        {
+            return status_.fetch_or(flags, std::memory_order_acq_rel);
+        }
+
+        // On an executor's worker other pending tasks are run meanwhile - the event may be set by a task
+        // queued behind them, and a worker blocked on it would deadlock a fixed-size pool.
+        // One worker helps - any other waiter blocks.
+        void wait()
+        {
+            if (is_done())
+                return;
+
+            Executor* executor = Executor::current();
+            Executor* no_helper = nullptr;
+
+            if (executor && helper_.compare_exchange_strong(no_helper, executor, std::memory_order_relaxed))
+            {
+                if (status_.fetch_or(has_helper, std::memory_order_acq_rel) & done)
+                    return; // set() did not see the helper
+
+                executor->help_until([this] { return is_done(); });
+                wait_for(helper_woken); // the executor may be destroyed once this worker returns
+                return;
+            }
+
+            wait_for(done);
+        }
+
+        // for reuse - nobody may wait
+        void reset() noexcept
+        {
+            helper_.store(nullptr, std::memory_order_relaxed);
+            status_.store(0, std::memory_order_relaxed);
+        }
+    };
+} // namespace Detail
+
+#endif // EXECUTOR_HPP
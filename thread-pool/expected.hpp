@@ -0,0 +1,260 @@
+#ifndef EXPECTED_HPP
+#define EXPECTED_HPP
+
+#include <version>
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+
+#include <expected>
+
+template <typename T, typename E>
+using Expected = std::expected<T, E>;
+
+template <typename E>
+using Unexpected = std::unexpected<E>;
+
+template <typename E>
+using BadExpectedAccess = std::bad_expected_access<E>;
+
+#else
+
+#include <concepts>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Subset of C++23 std::expected for C++20 standard libraries - replaced by an alias where <expected> is available.
+// Supported: construction from a value or Unexpected, has_value(), operator bool, *, ->, value(), error() & value_or().
+
+template <typename E>
+class Unexpected
+{
+    E error_;
+
+public:
+    template <typename Err = E>
+        requires std::constructible_from<E, Err>
+    constexpr explicit Unexpected(Err&& error)
+        : error_(std::forward<Err>(error))
+    {
+    }
+
+    constexpr const E& error() const& noexcept
+    {
+        return error_;
+    }
+
+    constexpr E& error() & noexcept
+    {
+        return error_;
+    }
+
+    constexpr E&& error() && noexcept
+    {
+        return std::move(error_);
+    }
+};
+
+template <typename E>
+Unexpected(E) -> Unexpected<E>;
+
+template <typename E>
+class BadExpectedAccess : public std::exception
+{
+    E error_;
+
+public:
+    explicit BadExpectedAccess(E error)
+        : error_(std::move(error))
+    {
+    }
+
+    const char* what() const noexcept override
+    {
+        return "bad access to Expected without a value";
+    }
+
+    const E& error() const noexcept
+    {
+        return error_;
+    }
+};
+
+template <typename T, typename E>
+class Expected
+{
+    std::variant<T, E> storage_;
+
+public:
+    using value_type = T;
+    using error_type = E;
+
+    constexpr Expected()
+        requires std::default_initializable<T>
+        : storage_{std::in_place_index<0>}
+    {
+    }
+
+    template <typename U = T>
+        requires(!std::same_as<std::remove_cvref_t<U>, Expected> && std::constructible_from<T, U>)
+    constexpr Expected(U&& value)
+        : storage_{std::in_place_index<0>, std::forward<U>(value)}
+    {
+    }
+
+    template <typename G>
+    constexpr Expected(const Unexpected<G>& error)
+        : storage_{std::in_place_index<1>, error.error()}
+    {
+    }
+
+    template <typename G>
+    constexpr Expected(Unexpected<G>&& error)
+        : storage_{std::in_place_index<1>, std::move(error).error()}
+    {
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return storage_.index() == 0;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr const T& operator*() const& noexcept
+    {
+        return *std::get_if<0>(&storage_);
+    }
+
+    constexpr T& operator*() & noexcept
+    {
+        return *std::get_if<0>(&storage_);
+    }
+
+    constexpr T&& operator*() && noexcept
+    {
+        return std::move(*std::get_if<0>(&storage_));
+    }
+
+    constexpr const T* operator->() const noexcept
+    {
+        return std::get_if<0>(&storage_);
+    }
+
+    constexpr T* operator->() noexcept
+    {
+        return std::get_if<0>(&storage_);
+    }
+
+    constexpr T& value() &
+    {
+        if (!has_value())
+            throw BadExpectedAccess<E>{error()};
+        return **this;
+    }
+
+    constexpr const T& value() const&
+    {
+        if (!has_value())
+            throw BadExpectedAccess<E>{error()};
+        return **this;
+    }
+
+    constexpr T&& value() &&
+    {
+        if (!has_value())
+            throw BadExpectedAccess<E>{std::move(error())};
+        return std::move(**this);
+    }
+
+    constexpr const E& error() const& noexcept
+    {
+        return *std::get_if<1>(&storage_);
+    }
+
+    constexpr E& error() & noexcept
+    {
+        return *std::get_if<1>(&storage_);
+    }
+
+    template <typename U>
+    constexpr T value_or(U&& default_value) const&
+    {
+        return has_value() ? **this : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    constexpr T value_or(U&& default_value) &&
+    {
+        return has_value() ? std::move(**this) : static_cast<T>(std::forward<U>(default_value));
+    }
+};
+
+// Expected<void, E> - success carries no value
+template <typename E>
+class Expected<void, E>
+{
+    std::variant<std::monostate, E> storage_;
+
+public:
+    using value_type = void;
+    using error_type = E;
+
+    constexpr Expected() noexcept = default;
+
+    template <typename G>
+    constexpr Expected(const Unexpected<G>& error)
+        : storage_{std::in_place_index<1>, error.error()}
+    {
+    }
+
+    template <typename G>
+    constexpr Expected(Unexpected<G>&& error)
+        : storage_{std::in_place_index<1>, std::move(error).error()}
+    {
+    }
+
+    constexpr bool has_value() const noexcept
+    {
+        return storage_.index() == 0;
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return has_value();
+    }
+
+    constexpr void operator*() const noexcept
+    {
+    }
+
+    constexpr void value() const
+    {
+        if (!has_value())
+            throw BadExpectedAccess<E>{error()};
+    }
+
+    constexpr const E& error() const& noexcept
+    {
+        return *std::get_if<1>(&storage_);
+    }
+
+    constexpr E& error() & noexcept
+    {
+        return *std::get_if<1>(&storage_);
+    }
+};
+
+#endif
+
+template <typename T>
+inline constexpr bool is_expected_v = false;
+
+template <typename T, typename E>
+inline constexpr bool is_expected_v<Expected<T, E>> = true;
+
+#endif // EXPECTED_HPP
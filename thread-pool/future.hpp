@@ -0,0 +1,701 @@
+#ifndef FUTURE_HPP
+#define FUTURE_HPP
+
+#include "executor.hpp"
+#include "task_arena.hpp"
+#include "task.hpp"
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// get() of a cancelled task that had not started
+class TaskCancelledError : public std::runtime_error
+{
+public:
+    TaskCancelledError()
+        : std::runtime_error{"Task was cancelled before it started"}
+    {
+    }
+};
+
+namespace Detail
+{
+    // Intrusive pointer to a reference counted shared state
+    template <typename State>
+    class StatePtr
+    {
+        template <typename>
+        friend class StatePtr;
+
+        State* ptr_{};
+
+    public:
+        StatePtr() = default;
+
+        explicit StatePtr(State* ptr) noexcept // adopts a reference
+            : ptr_{ptr}
+        {
+        }
+
+        StatePtr(const StatePtr& other) noexcept
+            : ptr_{other.ptr_}
+        {
+            if (ptr_)
+                ptr_->add_ref();
+        }
+
+        template <typename Other>
+            requires std::convertible_to<Other*, State*>
+        StatePtr(const StatePtr<Other>& other) noexcept
+            : ptr_{other.ptr_}
+        {
+            if (ptr_)
+                ptr_->add_ref();
+        }
+
+        StatePtr(StatePtr&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+        {
+        }
+
+        StatePtr& operator=(StatePtr other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            return *this;
+        }
+
+        ~StatePtr()
+        {
+            if (ptr_)
+                ptr_->release();
+        }
+
+        State* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        State* operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+    };
+
+    // Readiness, reference count & a single continuation - independent of the result type
+    class SharedStateBase
+    {
+        static constexpr unsigned has_continuation = CompletionFlag::first_user_flag;
+
+        std::atomic<unsigned> ref_count_;
+        mutable CompletionFlag status_; // ready - wait() registers a helping worker
+        Executor* executor_;
+        Executor* continuation_executor_{};
+        Task continuation_;
+
+        void run_continuation()
+        {
+            Task continuation = std::move(continuation_);
+
+            if (continuation_executor_)
+                continuation_executor_->try_post(std::move(continuation)); // a rejected continuation breaks its promise
+            else
+                continuation();
+        }
+
+    protected:
+        void make_ready()
+        {
+            const auto previous_status = status_.set();
+
+            if (previous_status & has_continuation)
+                run_continuation();
+        }
+
+    public:
+        SharedStateBase(unsigned initial_ref_count, Executor* executor)
+            : ref_count_{initial_ref_count}
+            , executor_{executor}
+        {
+        }
+
+        SharedStateBase(const SharedStateBase&) = delete;
+        SharedStateBase& operator=(const SharedStateBase&) = delete;
+
+        virtual ~SharedStateBase() = default;
+
+        void add_ref() noexcept
+        {
+            ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept
+        {
+            if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete this;
+        }
+
+        // executor that produces the result - continuations are scheduled on it
+        Executor* executor() const noexcept
+        {
+            return executor_;
+        }
+
+        bool is_ready() const noexcept
+        {
+            return status_.is_done();
+        }
+
+        // a waiting worker of an executor runs its other pending tasks meanwhile (CompletionFlag::wait)
+        void wait() const noexcept
+        {
+            status_.wait();
+        }
+
+        // continuation is posted to the executor or - if nullptr - run inline by the thread that makes the state ready
+        // only one continuation per state is allowed
+        void set_continuation(Task continuation, Executor* executor = nullptr)
+        {
+            continuation_ = std::move(continuation);
+            continuation_executor_ = executor;
+
+            const auto previous_status = status_.fetch_or(has_continuation);
+
+            if (previous_status & CompletionFlag::done)
+                run_continuation();
+        }
+    };
+
+    // Result channel shared by a task and its future
+    template <typename T>
+    class SharedState : public SharedStateBase
+    {
+        using StoredType = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        std::variant<std::monostate, StoredType, std::exception_ptr> result_;
+
+    protected:
+        template <typename... Args>
+        void store_value(Args&&... args)
+        {
+            result_.template emplace<1>(std::forward<Args>(args)...);
+        }
+
+        void store_exception(std::exception_ptr e)
+        {
+            result_.template emplace<2>(std::move(e));
+        }
+
+    public:
+        explicit SharedState(unsigned initial_ref_count = 1, Executor* executor = nullptr)
+            : SharedStateBase{initial_ref_count, executor}
+        {
+        }
+
+        template <typename... Args>
+        void set_value(Args&&... args)
+        {
+            store_value(std::forward<Args>(args)...);
+            make_ready();
+        }
+
+        void set_exception(std::exception_ptr e)
+        {
+            store_exception(std::move(e));
+            make_ready();
+        }
+
+        T get_result()
+        {
+            if (result_.index() == 2)
+                std::rethrow_exception(std::get<2>(result_));
+
+            if constexpr (!std::is_void_v<T>)
+                return std::move(std::get<1>(result_));
+        }
+    };
+
+    // Task states come from the worker's arena if created on a pool's worker
+    struct ArenaAllocated
+    {
+        static void* operator new(size_t size)
+        {
+            return TaskArena::allocate(size);
+        }
+
+        static void operator delete(void* ptr) noexcept
+        {
+            TaskArena::deallocate(ptr);
+        }
+
+        // over-aligned closures bypass the arena
+        static void* operator new(size_t size, std::align_val_t alignment)
+        {
+            return ::operator new(size, alignment);
+        }
+
+        static void operator delete(void* ptr, std::align_val_t alignment) noexcept
+        {
+            ::operator delete(ptr, alignment);
+        }
+    };
+
+    // Closure & result stored in one allocation
+    template <typename T, typename Function>
+    class TaskState final : public SharedState<T>, public ArenaAllocated
+    {
+        Function f_;
+
+    public:
+        template <typename F>
+        TaskState(F&& f, Executor* executor)
+            : SharedState<T>{2, executor} // task & future
+            , f_(std::forward<F>(f))
+        {
+        }
+
+        void run()
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    std::invoke(f_);
+                    this->store_value();
+                }
+                else
+                    this->store_value(std::invoke(f_));
+            }
+            catch (...)
+            {
+                this->store_exception(std::current_exception());
+            }
+
+            this->make_ready(); // may run a continuation - outside of try block
+        }
+
+        // the task was dropped before being run
+        void abandon()
+        {
+            this->set_exception(std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+        }
+    };
+
+    // f(stop_token) - a stop requested before the task starts completes the future right away,
+    // the queued task is then skipped without calling f
+    template <typename T, typename Function>
+    class CancellableTaskState final : public SharedState<T>, public ArenaAllocated
+    {
+        struct OnStopRequested
+        {
+            CancellableTaskState* state;
+
+            void operator()() noexcept
+            {
+                state->try_complete(std::make_exception_ptr(TaskCancelledError{}));
+            }
+        };
+
+        Function f_;
+        std::atomic<bool> is_claimed_{}; // by run(), abandon() or a stop request - whichever comes first
+        std::stop_token stop_token_;
+        std::stop_callback<OnStopRequested> on_stop_requested_;
+
+        void try_complete(std::exception_ptr e) noexcept
+        {
+            if (!is_claimed_.exchange(true, std::memory_order_acq_rel))
+                this->set_exception(std::move(e));
+        }
+
+    public:
+        template <typename F>
+        CancellableTaskState(F&& f, std::stop_token stop_token, Executor* executor)
+            : SharedState<T>{2, executor}
+            , f_(std::forward<F>(f))
+            , stop_token_{std::move(stop_token)}
+            , on_stop_requested_{stop_token_, OnStopRequested{this}}
+        {
+        }
+
+        void run()
+        {
+            if (is_claimed_.exchange(true, std::memory_order_acq_rel))
+                return; // cancelled while queued
+
+            if (stop_token_.stop_requested()) // its callback may not have run yet
+            {
+                this->set_exception(std::make_exception_ptr(TaskCancelledError{}));
+                return;
+            }
+
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    std::invoke(f_, stop_token_);
+                    this->store_value();
+                }
+                else
+                    this->store_value(std::invoke(f_, stop_token_));
+            }
+            catch (...)
+            {
+                this->store_exception(std::current_exception());
+            }
+
+            this->make_ready();
+        }
+
+        void abandon()
+        {
+            try_complete(std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+        }
+    };
+
+    // Callable pushed to a queue - pointer sized, so it fits in Task's small buffer
+    template <typename State>
+    class TaskRunner
+    {
+        StatePtr<State> state_;
+
+    public:
+        explicit TaskRunner(State* state) noexcept
+            : state_{state}
+        {
+        }
+
+        TaskRunner(TaskRunner&&) noexcept = default;
+        TaskRunner& operator=(TaskRunner&&) noexcept = default;
+
+        ~TaskRunner()
+        {
+            if (state_) // destroyed before being run
+                state_->abandon();
+        }
+
+        void operator()()
+        {
+            auto state = std::move(state_);
+            state->run();
+        }
+    };
+
+    struct FutureAccess
+    {
+        template <typename Future>
+        static auto& state(Future& f) noexcept
+        {
+            return f.state_;
+        }
+    };
+} // namespace Detail
+
+template <typename T>
+class Future
+{
+    friend struct Detail::FutureAccess;
+
+    Detail::StatePtr<Detail::SharedState<T>> state_;
+
+public:
+    Future() = default;
+
+    explicit Future(Detail::StatePtr<Detail::SharedState<T>> state) noexcept
+        : state_{std::move(state)}
+    {
+    }
+
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+    Future(Future&&) noexcept = default;
+    Future& operator=(Future&&) noexcept = default;
+
+    bool valid() const noexcept
+    {
+        return static_cast<bool>(state_);
+    }
+
+    bool is_ready() const noexcept
+    {
+        return state_->is_ready();
+    }
+
+    void wait() const noexcept
+    {
+        state_->wait();
+    }
+
+    T get()
+    {
+        auto state = std::move(state_);
+        state->wait();
+        return state->get_result();
+    }
+
+    // Schedules f on the executor that produces this future (inline if none) once the result is ready.
+    // f is called with the result (exceptions are propagated to the returned future) or with the ready Future<T>.
+    // Consumes the future.
+    template <typename Function>
+    auto then(Function&& f);
+};
+
+// Future of a task taking a std::stop_token - see make_cancellable_task()
+template <typename T>
+class CancellableFuture : public Future<T>
+{
+    std::stop_source stop_source_;
+
+public:
+    CancellableFuture() = default;
+
+    CancellableFuture(Future<T> future, std::stop_source stop_source) noexcept
+        : Future<T>{std::move(future)}
+        , stop_source_{std::move(stop_source)}
+    {
+    }
+
+    // A task that has not started is skipped - the future becomes ready at once, get() throws TaskCancelledError.
+    // A running task sees stop_requested() on its token - it decides when to return.
+    // Returns false if the task has been cancelled before.
+    bool cancel() noexcept
+    {
+        return stop_source_.request_stop();
+    }
+};
+
+template <typename T>
+class Promise
+{
+    Detail::StatePtr<Detail::SharedState<T>> state_;
+
+public:
+    explicit Promise(Executor* executor = nullptr)
+        : state_{new Detail::SharedState<T>{1, executor}}
+    {
+    }
+
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+    Promise(Promise&&) noexcept = default;
+    Promise& operator=(Promise&&) noexcept = default;
+
+    ~Promise()
+    {
+        if (state_ && !state_->is_ready())
+            state_->set_exception(std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+    }
+
+    Future<T> get_future()
+    {
+        return Future<T>{state_};
+    }
+
+    template <typename... Args>
+    void set_value(Args&&... args)
+    {
+        state_->set_value(std::forward<Args>(args)...);
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+        state_->set_exception(std::move(e));
+    }
+};
+
+// Returns a Task & a Future sharing a single heap allocation
+template <typename Function>
+auto make_task(Function&& f, Executor* executor = nullptr)
+{
+    using T = std::invoke_result_t<std::decay_t<Function>&>;
+    using State = Detail::TaskState<T, std::decay_t<Function>>;
+
+    auto* state = new State(std::forward<Function>(f), executor);
+
+    return std::pair{Task{Detail::TaskRunner<State>{state}}, Future<T>{Detail::StatePtr<Detail::SharedState<T>>{state}}};
+}
+
+// As make_task() for f(std::stop_token) - cancel() of the returned future requests stop
+template <typename Function>
+    requires std::invocable<std::decay_t<Function>&, std::stop_token>
+auto make_cancellable_task(Function&& f, Executor* executor = nullptr)
+{
+    using T = std::invoke_result_t<std::decay_t<Function>&, std::stop_token>;
+    using State = Detail::CancellableTaskState<T, std::decay_t<Function>>;
+
+    std::stop_source stop_source;
+    auto* state = new State(std::forward<Function>(f), stop_source.get_token(), executor);
+
+    return std::pair{Task{Detail::TaskRunner<State>{state}},
+        CancellableFuture<T>{Future<T>{Detail::StatePtr<Detail::SharedState<T>>{state}}, std::move(stop_source)}};
+}
+
+template <typename T>
+template <typename Function>
+auto Future<T>::then(Function&& f)
+{
+    auto state = std::move(state_);
+    Executor* executor = state->executor();
+
+    auto [continuation, f_result] = make_task(
+        [antecedent = state, f = std::forward<Function>(f)]() mutable {
+            Future<T> ready_future{std::move(antecedent)};
+
+            if constexpr (std::is_invocable_v<decltype(f)&, Future<T>>)
+                return std::invoke(f, std::move(ready_future));
+            else if constexpr (std::is_void_v<T>)
+            {
+                ready_future.get();
+                return std::invoke(f);
+            }
+            else
+                return std::invoke(f, ready_future.get());
+        },
+        executor);
+
+    state->set_continuation(std::move(continuation), executor);
+
+    return std::move(f_result);
+}
+
+template <typename Sequence>
+struct WhenAnyResult
+{
+    size_t index;
+    Sequence futures;
+};
+
+namespace Detail
+{
+    template <typename Sequence>
+    Future<Sequence> when_all(Sequence futures, std::span<StatePtr<SharedStateBase>> states)
+    {
+        struct WhenAllContext
+        {
+            Sequence futures;
+            std::atomic<size_t> remaining;
+            Promise<Sequence> promise;
+        };
+
+        Executor* executor = states.empty() ? nullptr : states.front()->executor();
+        auto ctx = std::make_shared<WhenAllContext>(std::move(futures), states.size(), Promise<Sequence>{executor});
+        auto f_result = ctx->promise.get_future();
+
+        if (states.empty())
+            ctx->promise.set_value(std::move(ctx->futures));
+
+        for (auto& state : states)
+            state->set_continuation([ctx] {
+                if (ctx->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    ctx->promise.set_value(std::move(ctx->futures));
+            });
+
+        return f_result;
+    }
+
+    // Every input keeps the continuation that forwards its result to a fresh state - the yielded futures
+    // have no continuation, so they can be passed to when_any() again or continued with then()
+    template <typename T>
+    Future<WhenAnyResult<std::vector<Future<T>>>> when_any(std::vector<Future<T>> inputs)
+    {
+        using Sequence = std::vector<Future<T>>;
+
+        struct WhenAnyContext
+        {
+            Sequence futures;
+            std::atomic<bool> is_done{};
+            Promise<WhenAnyResult<Sequence>> promise;
+        };
+
+        Executor* executor = inputs.empty() ? nullptr : FutureAccess::state(inputs.front())->executor();
+        auto ctx = std::make_shared<WhenAnyContext>(Sequence{}, false, Promise<WhenAnyResult<Sequence>>{executor});
+        auto f_result = ctx->promise.get_future();
+
+        if (inputs.empty())
+        {
+            ctx->promise.set_value(WhenAnyResult<Sequence>{static_cast<size_t>(-1), std::move(ctx->futures)});
+            return f_result;
+        }
+
+        std::vector<Promise<T>> forwards;
+        forwards.reserve(inputs.size());
+        ctx->futures.reserve(inputs.size());
+        for (auto& input : inputs)
+            ctx->futures.push_back(forwards.emplace_back(FutureAccess::state(input)->executor()).get_future());
+
+        // all yielded futures exist before the first continuation may run
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            auto state = FutureAccess::state(inputs[i]);
+
+            state->set_continuation([ctx, i, input = std::move(inputs[i]), forward = std::move(forwards[i])]() mutable {
+                try
+                {
+                    if constexpr (std::is_void_v<T>)
+                    {
+                        input.get();
+                        forward.set_value();
+                    }
+                    else
+                        forward.set_value(input.get());
+                }
+                catch (...)
+                {
+                    forward.set_exception(std::current_exception());
+                }
+
+                if (!ctx->is_done.exchange(true, std::memory_order_acq_rel))
+                    ctx->promise.set_value(WhenAnyResult<Sequence>{i, std::move(ctx->futures)});
+            });
+        }
+
+        return f_result;
+    }
+} // namespace Detail
+
+// Ready when all futures are ready - yields the (ready) futures
+template <typename T>
+Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures)
+{
+    std::vector<Detail::StatePtr<Detail::SharedStateBase>> states;
+    states.reserve(futures.size());
+    for (auto& f : futures)
+        states.emplace_back(Detail::FutureAccess::state(f));
+
+    return Detail::when_all(std::move(futures), std::span{states});
+}
+
+template <typename... Ts>
+Future<std::tuple<Future<Ts>...>> when_all(Future<Ts>... futures)
+{
+    std::array<Detail::StatePtr<Detail::SharedStateBase>, sizeof...(Ts)> states{Detail::FutureAccess::state(futures)...};
+
+    return Detail::when_all(std::tuple{std::move(futures)...}, std::span{states});
+}
+
+// Ready when any of futures is ready - yields the index of the first ready future & all the futures
+template <typename T>
+Future<WhenAnyResult<std::vector<Future<T>>>> when_any(std::vector<Future<T>> futures)
+{
+    return Detail::when_any(std::move(futures));
+}
+
+#endif // FUTURE_HPP
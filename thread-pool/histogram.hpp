@@ -0,0 +1,120 @@
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace Detail
+{
+    // counter with a single writer - readers see a recent value, the writer needs no read-modify-write
+    inline void add_relaxed(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+} // namespace Detail
+
+// Histogram with power-of-two buckets - bucket i counts values of bit width i: 0, 1, [2, 3], [4, 7], ...
+// Percentiles are reported as the upper bound of a bucket (at most 2x overestimated)
+class Log2Histogram
+{
+    friend class ConcurrentLog2Histogram;
+
+    std::array<uint64_t, 65> buckets_{};
+    uint64_t count_{};
+    uint64_t sum_{};
+    uint64_t max_{};
+
+public:
+    void record(uint64_t value) noexcept
+    {
+        ++buckets_[std::bit_width(value)];
+        ++count_;
+        sum_ += value;
+        max_ = std::max(max_, value);
+    }
+
+    void merge(const Log2Histogram& other) noexcept
+    {
+        for (size_t i = 0; i < buckets_.size(); ++i)
+            buckets_[i] += other.buckets_[i];
+
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    uint64_t count() const noexcept
+    {
+        return count_;
+    }
+
+    uint64_t max() const noexcept
+    {
+        return max_;
+    }
+
+    uint64_t mean() const noexcept
+    {
+        return count_ ? sum_ / count_ : 0;
+    }
+
+    // p in [0, 1]
+    uint64_t percentile(double p) const noexcept
+    {
+        if (count_ == 0)
+            return 0;
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * count_ + 0.5));
+
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < buckets_.size(); ++i)
+        {
+            accumulated += buckets_[i];
+
+            if (accumulated >= rank)
+            {
+                const uint64_t upper_bound = i < 64 ? (uint64_t{1} << i) - 1 : UINT64_MAX;
+                return std::min(upper_bound, max_);
+            }
+        }
+
+        return max_;
+    }
+};
+
+// Log2Histogram recorded by one thread & merged by others at any time - no lock, no read-modify-write.
+// A merge concurrent with record() may miss the latest values.
+class ConcurrentLog2Histogram
+{
+    std::array<std::atomic<uint64_t>, 65> buckets_{};
+    std::atomic<uint64_t> sum_{};
+    std::atomic<uint64_t> max_{};
+
+public:
+    void record(uint64_t value) noexcept
+    {
+        Detail::add_relaxed(buckets_[std::bit_width(value)], 1);
+        Detail::add_relaxed(sum_, value);
+
+        if (value > max_.load(std::memory_order_relaxed))
+            max_.store(value, std::memory_order_relaxed);
+    }
+
+    void merge_into(Log2Histogram& histogram) const noexcept
+    {
+        for (size_t i = 0; i < buckets_.size(); ++i)
+        {
+            const auto count = buckets_[i].load(std::memory_order_relaxed);
+            histogram.buckets_[i] += count;
+            histogram.count_ += count;
+        }
+
+        histogram.sum_ += sum_.load(std::memory_order_relaxed);
+        histogram.max_ = std::max(histogram.max_, max_.load(std::memory_order_relaxed));
+    }
+};
+
+#endif // HISTOGRAM_HPP
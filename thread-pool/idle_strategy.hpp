@@ -0,0 +1,109 @@
+#ifndef IDLE_STRATEGY_HPP
+#define IDLE_STRATEGY_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+// How an idle worker waits for tasks: spin (with a pause instruction), then yield, then park.
+// The spin time adapts to recent gaps between tasks - up to max_spin_time.
+struct IdleStrategy
+{
+    std::chrono::nanoseconds max_spin_time{0}; // 0 - no spinning
+    size_t yield_count{0};
+};
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+namespace Detail
+{
+    // Per-worker state of the idle strategy - not synchronized
+    class AdaptiveSpinner
+    {
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t spins_per_clock_check = 64;
+
+        IdleStrategy strategy_;
+        Clock::duration spin_time_;
+        Clock::time_point idle_since_;
+
+        // spinning twice as long as the last gap would have caught it
+        void adapt(Clock::duration gap)
+        {
+            if (gap < strategy_.max_spin_time)
+                spin_time_ = std::min<Clock::duration>(strategy_.max_spin_time, std::max(spin_time_, 2 * gap));
+            else
+                spin_time_ /= 2;
+        }
+
+    public:
+        explicit AdaptiveSpinner(const IdleStrategy& strategy)
+            : strategy_{strategy}
+            , spin_time_{strategy.max_spin_time}
+        {
+        }
+
+        bool is_enabled() const
+        {
+            return strategy_.max_spin_time > Clock::duration::zero() || strategy_.yield_count > 0;
+        }
+
+        // Spins, then yields until try_pop() succeeds - has_work() is a cheap check done before try_pop().
+        // Returns an empty result if the worker should park.
+        template <typename HasWork, typename TryPop>
+        std::invoke_result_t<TryPop&> spin(HasWork has_work, TryPop try_pop)
+        {
+            idle_since_ = Clock::now();
+
+            for (size_t i = 1; spin_time_ > Clock::duration::zero(); ++i)
+            {
+                if (has_work())
+                {
+                    if (auto result = try_pop())
+                    {
+                        adapt(Clock::now() - idle_since_);
+                        return result;
+                    }
+                }
+
+                cpu_relax();
+
+                if (i % spins_per_clock_check == 0 && Clock::now() - idle_since_ >= spin_time_)
+                    break;
+            }
+
+            for (size_t i = 0; i < strategy_.yield_count; ++i)
+            {
+                std::this_thread::yield();
+
+                if (has_work())
+                {
+                    if (auto result = try_pop())
+                    {
+                        adapt(Clock::now() - idle_since_);
+                        return result;
+                    }
+                }
+            }
+
+            return {};
+        }
+
+        // called when a parked worker got a task
+        void unparked()
+        {
+            adapt(Clock::now() - idle_since_);
+        }
+    };
+}
+
+#endif // IDLE_STRATEGY_HPP
@@ -0,0 +1,211 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include "task.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// How a range is split between the calling thread & the pool's workers
+// - static_chunks: one equal chunk per worker - lowest overhead for uniform work
+// - dynamic_chunks: chunks of chunk_size elements claimed one by one - balances irregular work
+// Chunks are always claimed from a shared counter, so an algorithm called from a pool's task cannot deadlock
+// waiting for workers - the caller runs every chunk nobody else has claimed.
+struct Chunking
+{
+    enum Mode
+    {
+        static_chunks,
+        dynamic_chunks
+    };
+
+    Mode mode = dynamic_chunks;
+    size_t chunk_size = 0; // dynamic_chunks only - 0: about 8 chunks per worker
+};
+
+namespace Detail
+{
+    struct ChunkedRange
+    {
+        size_t count;
+        size_t chunk_size;
+        size_t chunks_count;
+
+        ChunkedRange(size_t count, size_t workers_count, Chunking chunking)
+            : count{count}
+            , chunk_size{chunking.chunk_size}
+        {
+            if (chunking.mode == Chunking::static_chunks || chunk_size == 0)
+            {
+                const size_t chunks = std::max<size_t>(workers_count, 1) * (chunking.mode == Chunking::static_chunks ? 1 : 8);
+                chunk_size = std::max<size_t>(1, (count + chunks - 1) / chunks);
+            }
+
+            chunks_count = (count + chunk_size - 1) / chunk_size;
+        }
+
+        std::pair<size_t, size_t> chunk(size_t index) const
+        {
+            const size_t begin = index * chunk_size;
+            return {begin, std::min(count, begin + chunk_size)};
+        }
+    };
+
+    // shared with helper tasks - they may start after the caller has returned & then find no chunk left
+    struct ChunksState
+    {
+        const ChunkedRange range;
+        std::atomic<size_t> next_chunk{};
+        std::atomic<size_t> done_chunks{};
+        std::atomic<bool> has_failed{};
+        std::exception_ptr error;
+    };
+
+    // claims chunks until none is left - body(chunk_index, begin, end) is skipped once any chunk has thrown
+    template <typename ChunkBody>
+    void run_claimed_chunks(ChunksState& state, const ChunkBody& body) noexcept
+    {
+        const ChunkedRange& range = state.range;
+
+        for (size_t index; (index = state.next_chunk.fetch_add(1, std::memory_order_relaxed)) < range.chunks_count;)
+        {
+            if (!state.has_failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    const auto [begin, end] = range.chunk(index);
+                    body(index, begin, end);
+                }
+                catch (...)
+                {
+                    if (!state.has_failed.exchange(true))
+                        state.error = std::current_exception();
+                }
+            }
+
+            if (state.done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == range.chunks_count)
+                state.done_chunks.notify_all();
+        }
+    }
+
+    // runs body for every chunk on the caller & up to pool.size() workers - returns when all chunks are done
+    template <typename Pool, typename ChunkBody>
+    void for_each_chunk(Pool& pool, const ChunkedRange& range, const ChunkBody& body)
+    {
+        if (range.chunks_count <= 1)
+        {
+            if (range.chunks_count == 1)
+                body(0, 0, range.count);
+            return;
+        }
+
+        auto state = std::make_shared<ChunksState>(range);
+
+        const size_t helpers_count = std::min(range.chunks_count - 1, pool.size());
+        for (size_t i = 0; i < helpers_count; ++i)
+        {
+            // body is only used for claimed chunks - the caller waits for them
+            if (pool.try_post(Task{[state, &body] { run_claimed_chunks(*state, body); }}))
+                break; // pool rejects tasks - the caller runs the remaining chunks
+        }
+
+        run_claimed_chunks(*state, body);
+
+        for (size_t done; (done = state->done_chunks.load(std::memory_order_acquire)) != range.chunks_count;)
+            state->done_chunks.wait(done, std::memory_order_acquire);
+
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+} // namespace Detail
+
+// f(*it) for every element - f(i) for every index if the bounds are integral
+template <typename Pool, std::random_access_iterator Iterator, typename Function>
+void parallel_for(Pool& pool, Iterator first, Iterator last, Function f, Chunking chunking = {})
+{
+    const Detail::ChunkedRange range{static_cast<size_t>(last - first), pool.size(), chunking};
+
+    Detail::for_each_chunk(pool, range, [first, &f](size_t, size_t begin, size_t end) {
+        std::for_each(first + begin, first + end, std::ref(f));
+    });
+}
+
+template <typename Pool, std::integral Index, typename Function>
+void parallel_for(Pool& pool, Index first, Index last, Function f, Chunking chunking = {})
+{
+    const Detail::ChunkedRange range{last > first ? static_cast<size_t>(last - first) : 0, pool.size(), chunking};
+
+    Detail::for_each_chunk(pool, range, [first, &f](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            f(static_cast<Index>(first + i));
+    });
+}
+
+// Partial results of chunks are combined in chunk order - reduce must be associative, need not be commutative
+template <typename Pool, std::random_access_iterator Iterator, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(Pool& pool, Iterator first, Iterator last, T init, Reduce reduce, Transform transform, Chunking chunking = {})
+{
+    const Detail::ChunkedRange range{static_cast<size_t>(last - first), pool.size(), chunking};
+
+    std::vector<std::optional<T>> partials(range.chunks_count);
+
+    Detail::for_each_chunk(pool, range, [first, &partials, &reduce, &transform](size_t index, size_t begin, size_t end) {
+        T partial = transform(first[begin]);
+        for (size_t i = begin + 1; i < end; ++i)
+            partial = reduce(std::move(partial), transform(first[i]));
+        partials[index].emplace(std::move(partial));
+    });
+
+    for (auto& partial : partials)
+        init = reduce(std::move(init), std::move(*partial));
+
+    return init;
+}
+
+// Two passes: chunk totals are computed in parallel & scanned by the caller, then every chunk is scanned from its offset.
+// Returns the end of the output range.
+template <typename Pool, std::random_access_iterator Iterator, std::random_access_iterator OutputIterator, typename BinaryOp = std::plus<>>
+OutputIterator parallel_inclusive_scan(Pool& pool, Iterator first, Iterator last, OutputIterator d_first, BinaryOp op = {}, Chunking chunking = {})
+{
+    using T = std::iter_value_t<Iterator>;
+
+    const Detail::ChunkedRange range{static_cast<size_t>(last - first), pool.size(), chunking};
+
+    std::vector<std::optional<T>> totals(range.chunks_count);
+
+    Detail::for_each_chunk(pool, range, [first, &totals, &op](size_t index, size_t begin, size_t end) {
+        T total = first[begin];
+        for (size_t i = begin + 1; i < end; ++i)
+            total = op(std::move(total), first[i]);
+        totals[index].emplace(std::move(total));
+    });
+
+    // totals[i] becomes the sum of all chunks before chunk i (chunk 0 has no offset)
+    for (size_t i = 1; i < totals.size(); ++i)
+        totals[i] = op(*totals[i - 1], std::move(*totals[i]));
+
+    Detail::for_each_chunk(pool, range, [first, d_first, &totals, &op](size_t index, size_t begin, size_t end) {
+        T sum = index == 0 ? T(first[begin]) : op(*totals[index - 1], first[begin]);
+        d_first[begin] = sum;
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            sum = op(std::move(sum), first[i]);
+            d_first[i] = sum;
+        }
+    });
+
+    return d_first + range.count;
+}
+
+#endif // PARALLEL_ALGORITHMS_HPP
@@ -0,0 +1,446 @@
+#ifndef PRIORITY_TASK_QUEUE_HPP
+#define PRIORITY_TASK_QUEUE_HPP
+
+#include "histogram.hpp"
+#include "task.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+enum class TaskPriority : unsigned
+{
+    high,
+    normal,
+    low
+};
+
+constexpr size_t task_priority_levels = 3;
+
+class QueueFullError : public std::runtime_error
+{
+public:
+    QueueFullError()
+        : std::runtime_error{"Task queue is full"}
+    {
+    }
+};
+
+// Blocking MPMC queue of tasks with one FIFO lane per priority.
+// Lanes are drained in priority order, but a non-empty lower lane is served at least once
+// per starvation_limit tasks taken from higher lanes.
+// At most capacity tasks are queued - push blocks until there is space, try_push fails.
+// After close() push, push_bulk & try_push_bulk throw, try_push & push_if_open fail (unless accept_if_closed is set)
+// and pops return without a task once the queue is drained.
+// Pushes do not wake parked consumers while spinning consumers can take the tasks.
+class PriorityTaskQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct LaneStats
+    {
+        size_t depth;
+        uint64_t dequeued_count;
+        Clock::duration mean_wait;
+        Clock::duration p50_wait;
+        Clock::duration p99_wait;
+        Clock::duration max_wait;
+    };
+
+    struct Dequeued
+    {
+        Clock::duration wait_time; // how long the task waited in the queue
+        size_t depth; // tasks in the queue when it was taken (including the taken one)
+        TaskPriority priority;
+    };
+
+private:
+    struct Entry
+    {
+        Task task;
+        Clock::time_point enqueued_at;
+    };
+
+    struct Lane
+    {
+        std::deque<Entry> entries;
+        size_t skipped{}; // pops served from higher lanes since this lane was served
+        Log2Histogram wait_times; // in ns
+    };
+
+    std::array<Lane, task_priority_levels> lanes_;
+    mutable std::mutex mtx_q_;
+    std::condition_variable cv_q_not_empty_;
+    std::condition_variable cv_q_not_full_;
+    size_t size_{};
+    std::atomic<size_t> size_hint_{}; // size_ readable without the lock
+    size_t waiting_consumers_{};
+    std::atomic<size_t> spinning_consumers_{};
+    size_t waiting_producers_{};
+    std::atomic<uint64_t> wake_epoch_{}; // advanced by wake_consumers()
+    bool is_closed_{};
+    const size_t starvation_limit_;
+    const size_t capacity_;
+
+    void throw_if_closed(bool accept_if_closed) const
+    {
+        if (is_closed_ && !accept_if_closed)
+            throw std::runtime_error{"Push to a closed queue"};
+    }
+
+    // waits until a task fits - or the queue gets closed
+    void wait_for_space(std::unique_lock<std::mutex>& lk, bool accept_if_closed)
+    {
+        if (size_ < capacity_)
+            return;
+
+        ++waiting_producers_;
+        cv_q_not_full_.wait(lk, [&] { return size_ < capacity_ || (is_closed_ && !accept_if_closed); });
+        --waiting_producers_;
+    }
+
+    void push_locked(Task&& task, TaskPriority priority, Clock::time_point now)
+    {
+        lanes_[static_cast<size_t>(priority)].entries.push_back(Entry{std::move(task), now});
+        size_hint_.store(++size_, std::memory_order_relaxed);
+    }
+
+    // wakes only as many consumers as needed for count new tasks
+    void notify_consumers_locked(size_t count)
+    {
+        const size_t to_wake = std::min(count, unclaimed_locked());
+        if (to_wake >= waiting_consumers_)
+            cv_q_not_empty_.notify_all();
+        else
+            for (size_t i = 0; i < to_wake; ++i)
+                cv_q_not_empty_.notify_one();
+    }
+
+    Lane& select_lane()
+    {
+        size_t selected = task_priority_levels;
+
+        for (size_t i = 0; i < task_priority_levels; ++i)
+        {
+            if (lanes_[i].entries.empty())
+                continue;
+
+            if (selected == task_priority_levels)
+                selected = i;
+            else if (lanes_[i].skipped >= starvation_limit_)
+            {
+                selected = i;
+                break;
+            }
+        }
+
+        for (size_t i = selected + 1; i < task_priority_levels; ++i)
+        {
+            if (!lanes_[i].entries.empty())
+                ++lanes_[i].skipped;
+        }
+
+        lanes_[selected].skipped = 0;
+
+        return lanes_[selected];
+    }
+
+    Dequeued pop_locked(Task& task)
+    {
+        Lane& lane = select_lane();
+        const Dequeued dequeued{Clock::now() - lane.entries.front().enqueued_at, size_, static_cast<TaskPriority>(&lane - lanes_.data())};
+
+        task = std::move(lane.entries.front().task);
+        lane.wait_times.record(std::chrono::nanoseconds(dequeued.wait_time).count());
+        lane.entries.pop_front();
+        size_hint_.store(--size_, std::memory_order_relaxed);
+
+        // blocked producers are woken together once the queue is half drained - not one context switch per pop
+        if (waiting_producers_ != 0 && size_ <= capacity_ / 2)
+            cv_q_not_full_.notify_all();
+
+        return dequeued;
+    }
+
+    size_t backlog_locked() const
+    {
+        const size_t idle = waiting_consumers_ + spinning_consumers_.load(std::memory_order_relaxed);
+        return size_ > idle ? size_ - idle : 0;
+    }
+
+    // tasks not covered by spinning consumers
+    size_t unclaimed_locked() const
+    {
+        const size_t spinning = spinning_consumers_.load(std::memory_order_relaxed);
+        return size_ > spinning ? size_ - spinning : 0;
+    }
+
+public:
+    static constexpr size_t default_starvation_limit = 16;
+    static constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+
+    explicit PriorityTaskQueue(size_t starvation_limit = default_starvation_limit, size_t capacity = unbounded)
+        : starvation_limit_{starvation_limit}
+        , capacity_{capacity}
+    {
+        if (capacity_ == 0)
+            throw std::invalid_argument{"Queue capacity must be positive"};
+    }
+
+    PriorityTaskQueue(const PriorityTaskQueue&) = delete;
+    PriorityTaskQueue& operator=(const PriorityTaskQueue&) = delete;
+
+    bool empty() const
+    {
+        std::lock_guard lk{mtx_q_};
+        return size_ == 0;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // push, try_push & push_bulk return the backlog - number of queued tasks not matched by a waiting or spinning consumer
+    size_t push(Task&& task, TaskPriority priority = TaskPriority::normal, bool accept_if_closed = false)
+    {
+        std::unique_lock lk{mtx_q_};
+        wait_for_space(lk, accept_if_closed);
+        throw_if_closed(accept_if_closed);
+        push_locked(std::move(task), priority, Clock::now());
+        notify_consumers_locked(1);
+
+        return backlog_locked();
+    }
+
+    // waits for space like push() - std::nullopt if the queue is closed, the task is left untouched
+    std::optional<size_t> push_if_open(Task& task, TaskPriority priority = TaskPriority::normal)
+    {
+        std::unique_lock lk{mtx_q_};
+        wait_for_space(lk, false);
+
+        if (is_closed_)
+            return std::nullopt;
+
+        push_locked(std::move(task), priority, Clock::now());
+        notify_consumers_locked(1);
+
+        return backlog_locked();
+    }
+
+    // std::nullopt if the queue is full or closed - the task is left untouched
+    std::optional<size_t> try_push(Task& task, TaskPriority priority = TaskPriority::normal, bool accept_if_closed = false)
+    {
+        std::lock_guard lk{mtx_q_};
+
+        if (size_ >= capacity_ || (is_closed_ && !accept_if_closed))
+            return std::nullopt;
+
+        push_locked(std::move(task), priority, Clock::now());
+        notify_consumers_locked(1);
+
+        return backlog_locked();
+    }
+
+    // Moves all tasks under one lock & wakes only as many consumers as needed.
+    // When the queue fills up, the pushed part is handed to consumers before waiting for space.
+    template <std::ranges::input_range Range>
+    size_t push_bulk(Range&& tasks, TaskPriority priority = TaskPriority::normal, bool accept_if_closed = false)
+    {
+        std::unique_lock lk{mtx_q_};
+        throw_if_closed(accept_if_closed);
+
+        auto now = Clock::now();
+        size_t count = 0;
+
+        for (auto&& task : tasks)
+        {
+            if (size_ >= capacity_)
+            {
+                notify_consumers_locked(count);
+                count = 0;
+
+                wait_for_space(lk, accept_if_closed);
+                throw_if_closed(accept_if_closed);
+                now = Clock::now();
+            }
+
+            push_locked(std::move(task), priority, now);
+            ++count;
+        }
+
+        notify_consumers_locked(count);
+
+        return backlog_locked();
+    }
+
+    // all or nothing - std::nullopt (and tasks left untouched) if they do not fit
+    std::optional<size_t> try_push_bulk(std::span<Task> tasks, TaskPriority priority = TaskPriority::normal, bool accept_if_closed = false)
+    {
+        std::lock_guard lk{mtx_q_};
+        throw_if_closed(accept_if_closed);
+
+        if (tasks.size() > capacity_ - size_)
+            return std::nullopt;
+
+        const auto now = Clock::now();
+        for (auto& task : tasks)
+            push_locked(std::move(task), priority, now);
+
+        notify_consumers_locked(tasks.size());
+
+        return backlog_locked();
+    }
+
+    // returns false if the queue is closed & drained
+    bool pop(Task& task)
+    {
+        std::unique_lock lk{mtx_q_};
+        ++waiting_consumers_;
+        cv_q_not_empty_.wait(lk, [this] { return size_ != 0 || is_closed_; });
+        --waiting_consumers_;
+
+        if (size_ == 0)
+            return false;
+
+        pop_locked(task);
+        return true;
+    }
+
+    // std::nullopt on timeout or if the queue is closed & drained
+    std::optional<Dequeued> pop_for(Task& task, Clock::duration timeout)
+    {
+        std::unique_lock lk{mtx_q_};
+        ++waiting_consumers_;
+        cv_q_not_empty_.wait_for(lk, timeout, [this] { return size_ != 0 || is_closed_; });
+        --waiting_consumers_;
+
+        if (size_ == 0)
+            return std::nullopt;
+
+        return pop_locked(task);
+    }
+
+    // Waits for a task - or until wake_consumers() moves the epoch past epoch.
+    // Ignores close() - the caller waits for an event that will come.
+    std::optional<Dequeued> pop_until_woken(Task& task, uint64_t epoch)
+    {
+        std::unique_lock lk{mtx_q_};
+        ++waiting_consumers_;
+        cv_q_not_empty_.wait(lk, [&] { return size_ != 0 || wake_epoch_.load(std::memory_order_relaxed) != epoch; });
+        --waiting_consumers_;
+
+        if (size_ == 0)
+            return std::nullopt;
+
+        return pop_locked(task);
+    }
+
+    uint64_t wake_epoch() const noexcept
+    {
+        return wake_epoch_.load(std::memory_order_acquire);
+    }
+
+    // returns consumers waiting in pop_until_woken() with an older epoch
+    void wake_consumers()
+    {
+        std::lock_guard lk{mtx_q_};
+        wake_epoch_.fetch_add(1, std::memory_order_release);
+        cv_q_not_empty_.notify_all();
+    }
+
+    std::optional<Dequeued> try_pop(Task& task)
+    {
+        std::unique_lock lk{mtx_q_, std::try_to_lock};
+
+        if (lk.owns_lock() && size_ != 0)
+            return pop_locked(task);
+
+        return std::nullopt;
+    }
+
+    // lock-free check for spinning consumers - may be stale
+    bool maybe_has_tasks() const noexcept
+    {
+        return size_hint_.load(std::memory_order_relaxed) != 0;
+    }
+
+    // a spinning consumer must re-check the queue under the lock (pop/pop_for) before it parks
+    void add_spinning_consumer() noexcept
+    {
+        spinning_consumers_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void remove_spinning_consumer() noexcept
+    {
+        spinning_consumers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void close()
+    {
+        std::lock_guard lk{mtx_q_};
+        is_closed_ = true;
+        cv_q_not_empty_.notify_all();
+        cv_q_not_full_.notify_all();
+    }
+
+    bool is_closed() const
+    {
+        std::lock_guard lk{mtx_q_};
+        return is_closed_;
+    }
+
+    // removes all queued tasks - they are returned, so they can be destroyed outside of the lock
+    std::vector<Task> clear()
+    {
+        std::vector<Task> tasks;
+
+        std::lock_guard lk{mtx_q_};
+        tasks.reserve(size_);
+        for (auto& lane : lanes_)
+        {
+            for (auto& entry : lane.entries)
+                tasks.push_back(std::move(entry.task));
+            lane.entries.clear();
+        }
+        size_ = 0;
+        size_hint_.store(0, std::memory_order_relaxed);
+        cv_q_not_full_.notify_all();
+
+        return tasks;
+    }
+
+    std::array<LaneStats, task_priority_levels> lane_stats() const
+    {
+        std::lock_guard lk{mtx_q_};
+
+        std::array<LaneStats, task_priority_levels> stats;
+        for (size_t i = 0; i < task_priority_levels; ++i)
+        {
+            const auto& wait_times = lanes_[i].wait_times;
+            stats[i] = LaneStats{
+                lanes_[i].entries.size(),
+                wait_times.count(),
+                std::chrono::nanoseconds(wait_times.mean()),
+                std::chrono::nanoseconds(wait_times.percentile(0.5)),
+                std::chrono::nanoseconds(wait_times.percentile(0.99)),
+                std::chrono::nanoseconds(wait_times.max())};
+        }
+
+        return stats;
+    }
+};
+
+#endif // PRIORITY_TASK_QUEUE_HPP
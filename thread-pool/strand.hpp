@@ -0,0 +1,201 @@
+#ifndef STRAND_HPP
+#define STRAND_HPP
+
+#include "executor.hpp"
+#include "future.hpp"
+#include "task.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Detail
+{
+    // Lock-free MPSC queue of tasks (intrusive Vyukov queue with a stub node) & the strand's ownership count.
+    // The thread that raises pending_ from zero owns the strand - only the owner pops & runs tasks.
+    class StrandState : public std::enable_shared_from_this<StrandState>
+    {
+        struct Node
+        {
+            Task task;
+            std::atomic<Node*> next{};
+        };
+
+        // posted to the executor - runs a batch of tasks, then re-posts itself if more are pending
+        class Runner
+        {
+            std::shared_ptr<StrandState> state_;
+
+        public:
+            explicit Runner(std::shared_ptr<StrandState> state) noexcept
+                : state_{std::move(state)}
+            {
+            }
+
+            Runner(Runner&&) noexcept = default;
+            Runner& operator=(Runner&&) noexcept = default;
+
+            ~Runner()
+            {
+                if (state_ && !state_->keeps_rejected_runner_) // dropped or rejected by the executor
+                    state_->drop_pending();
+            }
+
+            void operator()()
+            {
+                auto state = std::move(state_);
+                state->run();
+            }
+        };
+
+        Executor& executor_;
+        const size_t batch_size_;
+        Node* tail_; // consumer side - the stub node
+        std::atomic<Node*> head_; // producer side
+        std::atomic<size_t> pending_{}; // queued tasks + the one being run
+        bool keeps_rejected_runner_{}; // the owner runs on instead of a rejected re-post - only the owner touches it
+
+        inline static thread_local const StrandState* current_ = nullptr;
+
+        // only the owner pops - pending_ guarantees that a task is queued, its producer may not have linked it yet
+        Task pop() noexcept
+        {
+            Node* next;
+            while (!(next = tail_->next.load(std::memory_order_acquire)))
+                std::this_thread::yield();
+
+            delete tail_;
+            tail_ = next; // becomes the stub
+
+            return std::move(next->task);
+        }
+
+        void run()
+        {
+            const auto* previous = std::exchange(current_, this);
+
+            while (true)
+            {
+                for (size_t i = 0; i < batch_size_; ++i)
+                {
+                    pop()();
+
+                    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        current_ = previous;
+                        return;
+                    }
+                }
+
+                // the worker is handed back to the executor - other strands & tasks are not starved
+                Task rejected = executor_.try_post(Task{Runner{shared_from_this()}});
+
+                if (!rejected)
+                {
+                    current_ = previous;
+                    return;
+                }
+
+                // the executor rejected the runner - keep running on this thread
+                keeps_rejected_runner_ = true;
+                rejected = Task{};
+                keeps_rejected_runner_ = false;
+            }
+        }
+
+        // tasks of a strand whose runner was dropped are destroyed - their futures get broken_promise
+        void drop_pending() noexcept
+        {
+            do
+            {
+                Task task = pop();
+            } while (pending_.fetch_sub(1, std::memory_order_acq_rel) != 1);
+        }
+
+    public:
+        StrandState(Executor& executor, size_t batch_size)
+            : executor_{executor}
+            , batch_size_{batch_size}
+            , tail_{new Node}
+            , head_{tail_}
+        {
+            if (batch_size_ == 0)
+                throw std::invalid_argument{"Strand batch size must be positive"};
+        }
+
+        StrandState(const StrandState&) = delete;
+        StrandState& operator=(const StrandState&) = delete;
+
+        ~StrandState()
+        {
+            for (Node* node = tail_; node;)
+                delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+        }
+
+        // if the executor rejects the runner, pending tasks are dropped - their futures get broken_promise
+        void post(Task&& task)
+        {
+            Node* node = new Node{std::move(task)};
+            head_.exchange(node, std::memory_order_acq_rel)->next.store(node, std::memory_order_release);
+
+            if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+                executor_.try_post(Task{Runner{shared_from_this()}}); // a rejected runner is dropped
+        }
+
+        bool is_current() const noexcept
+        {
+            return current_ == this;
+        }
+    };
+} // namespace Detail
+
+// Executor running tasks one at a time in FIFO order on the underlying executor's workers.
+// Tasks of different strands run in parallel - no worker blocks waiting for a strand.
+// A runner takes at most batch_size tasks before it is re-posted behind other queued work.
+// Continuations of submitted futures are posted to the strand - it must outlive them.
+class Strand : public Executor
+{
+    std::shared_ptr<Detail::StrandState> state_;
+
+public:
+    explicit Strand(Executor& executor, size_t batch_size = 64)
+        : state_{std::make_shared<Detail::StrandState>(executor, batch_size)}
+    {
+    }
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    // a task accepted by the strand is never returned - if the executor rejects the strand's runner,
+    // pending tasks are dropped instead
+    void post(Task&& task) override
+    {
+        state_->post(std::move(task));
+    }
+
+    Task try_post(Task&& task) override
+    {
+        state_->post(std::move(task));
+        return {};
+    }
+
+    template <typename Function>
+    auto submit(Function&& f)
+    {
+        auto [task, f_result] = make_task(std::forward<Function>(f), this);
+        post(std::move(task));
+
+        return std::move(f_result);
+    }
+
+    // true inside a task of this strand
+    bool running_in_this_thread() const noexcept
+    {
+        return state_->is_current();
+    }
+};
+
+#endif // STRAND_HPP
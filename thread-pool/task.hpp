@@ -0,0 +1,122 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only type-erased void() callable
+// - closures up to small_buffer_size bytes (nothrow movable) are stored inline - no heap allocation
+// - sizeof(Task) == 40 on 64-bit platforms
+class Task
+{
+public:
+    static constexpr size_t small_buffer_size = 4 * sizeof(void*);
+
+private:
+    struct VTable
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* dest, void* src) noexcept; // move-constructs dest from src & destroys src
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename F>
+    static constexpr bool fits_small_buffer = sizeof(F) <= small_buffer_size
+        && alignof(F) <= alignof(void*)
+        && std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr VTable small_vtable{
+        [](void* storage) { std::invoke(*static_cast<F*>(storage)); },
+        [](void* dest, void* src) noexcept {
+            ::new (dest) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* storage) noexcept { static_cast<F*>(storage)->~F(); }};
+
+    template <typename F>
+    static constexpr VTable large_vtable{
+        [](void* storage) { std::invoke(**static_cast<F**>(storage)); },
+        [](void* dest, void* src) noexcept { ::new (dest) F*(*static_cast<F**>(src)); },
+        [](void* storage) noexcept { delete *static_cast<F**>(storage); }};
+
+    alignas(void*) std::byte buffer_[small_buffer_size];
+    const VTable* vtable_{};
+
+    void reset() noexcept
+    {
+        if (vtable_)
+        {
+            vtable_->destroy(buffer_);
+            vtable_ = nullptr;
+        }
+    }
+
+public:
+    Task() noexcept = default;
+
+    template <typename F>
+        requires(!std::same_as<std::remove_cvref_t<F>, Task> && std::invocable<std::decay_t<F>&>)
+    Task(F&& f)
+    {
+        using Callable = std::decay_t<F>;
+
+        if constexpr (fits_small_buffer<Callable>)
+        {
+            ::new (static_cast<void*>(buffer_)) Callable(std::forward<F>(f));
+            vtable_ = &small_vtable<Callable>;
+        }
+        else
+        {
+            ::new (static_cast<void*>(buffer_)) Callable*(new Callable(std::forward<F>(f)));
+            vtable_ = &large_vtable<Callable>;
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept
+        : vtable_{std::exchange(other.vtable_, nullptr)}
+    {
+        if (vtable_)
+            vtable_->move(buffer_, other.buffer_);
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.vtable_)
+            {
+                other.vtable_->move(buffer_, other.buffer_);
+                vtable_ = std::exchange(other.vtable_, nullptr);
+            }
+        }
+
+        return *this;
+    }
+
+    ~Task()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return vtable_ != nullptr;
+    }
+
+    void operator()()
+    {
+        vtable_->invoke(buffer_);
+    }
+};
+
+#endif // TASK_HPP
@@ -0,0 +1,208 @@
+#ifndef TASK_ARENA_HPP
+#define TASK_ARENA_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace Detail
+{
+    // Slab allocator for task states created by one thread (a pool's worker).
+    // - the owner allocates & frees without atomics: per size class free lists & bump allocation from 64 KiB slabs
+    // - other threads return blocks through a lock-free list, the owner takes them back when a free list runs dry
+    // - the arena outlives its owner until the last block is freed (futures may outlive the pool)
+    // Threads without an arena & objects above max_payload_size use the global allocator.
+    class TaskArena
+    {
+        static constexpr size_t slab_size = 64 * 1024;
+        static constexpr std::array<size_t, 4> payload_sizes{64, 128, 256, 512};
+        static constexpr size_t max_payload_size = payload_sizes.back();
+
+        // in front of every block - also of blocks from the global allocator (owner == nullptr)
+        struct alignas(16) Header
+        {
+            TaskArena* owner;
+            size_t size_class;
+        };
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        inline static thread_local TaskArena* current_ = nullptr;
+
+        // owner only
+        std::array<FreeBlock*, payload_sizes.size()> free_lists_{};
+        std::byte* bump_{};
+        std::byte* slab_end_{};
+        std::vector<std::byte*> slabs_;
+        int64_t live_blocks_{}; // allocated minus freed by the owner
+
+        // shared with other threads
+        alignas(64) std::atomic<FreeBlock*> remote_frees_{};
+        std::atomic<int64_t> remote_balance_{}; // remote frees so far - minus live_blocks_ once the owner detaches
+
+        TaskArena() = default;
+
+        ~TaskArena()
+        {
+            for (auto* slab : slabs_)
+                ::operator delete(slab, std::align_val_t{64});
+        }
+
+        static size_t size_class(size_t size) noexcept
+        {
+            return static_cast<size_t>(std::bit_width((std::max<size_t>(size, 1) - 1) / payload_sizes.front()));
+        }
+
+        // Blocks are not multiples of a cache line, so consecutive blocks start at different offsets within one.
+        // Equal offsets would map every state's atomic to the same bucket of libstdc++'s atomic wait table -
+        // then each notify_all() of a state would issue a futex syscall while any future is being waited for.
+        static size_t block_size(size_t size_class) noexcept
+        {
+            return sizeof(Header) + payload_sizes[size_class];
+        }
+
+        static Header* header(void* ptr) noexcept
+        {
+            return static_cast<Header*>(ptr) - 1;
+        }
+
+        void reclaim_remote_frees() noexcept
+        {
+            for (FreeBlock* block = remote_frees_.exchange(nullptr, std::memory_order_acquire); block;)
+            {
+                FreeBlock* next = block->next;
+                auto& free_list = free_lists_[header(block)->size_class];
+                block->next = free_list;
+                free_list = block;
+                block = next;
+            }
+        }
+
+        void* allocate_block(size_t size_class)
+        {
+            auto& free_list = free_lists_[size_class];
+
+            if (!free_list)
+                reclaim_remote_frees();
+
+            ++live_blocks_;
+
+            if (FreeBlock* block = free_list)
+            {
+                free_list = block->next;
+                return block;
+            }
+
+            const size_t size = block_size(size_class);
+
+            if (static_cast<size_t>(slab_end_ - bump_) < size)
+            {
+                try
+                {
+                    slabs_.reserve(slabs_.size() + 1);
+                    bump_ = static_cast<std::byte*>(::operator new(slab_size, std::align_val_t{64}));
+                }
+                catch (...)
+                {
+                    --live_blocks_;
+                    throw;
+                }
+
+                slabs_.push_back(bump_);
+                slab_end_ = bump_ + slab_size;
+            }
+
+            auto* block_header = ::new (static_cast<void*>(bump_)) Header{this, size_class};
+            bump_ += size;
+
+            return block_header + 1;
+        }
+
+        void free_local(void* ptr) noexcept
+        {
+            auto* block = static_cast<FreeBlock*>(ptr);
+            auto& free_list = free_lists_[header(ptr)->size_class];
+            block->next = free_list;
+            free_list = block;
+            --live_blocks_;
+        }
+
+        void free_remote(void* ptr) noexcept
+        {
+            auto* block = static_cast<FreeBlock*>(ptr);
+            block->next = remote_frees_.load(std::memory_order_relaxed);
+            while (!remote_frees_.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+                ;
+
+            if (remote_balance_.fetch_add(1, std::memory_order_acq_rel) + 1 == 0) // the last block of a detached arena
+                delete this;
+        }
+
+        void detach() noexcept
+        {
+            if (remote_balance_.fetch_sub(live_blocks_, std::memory_order_acq_rel) - live_blocks_ == 0)
+                delete this;
+        }
+
+    public:
+        TaskArena(const TaskArena&) = delete;
+        TaskArena& operator=(const TaskArena&) = delete;
+
+        // gives the calling thread an arena for its lifetime (or the attachment's)
+        class Attachment
+        {
+            TaskArena* arena_;
+
+        public:
+            Attachment()
+                : arena_{new TaskArena}
+            {
+                current_ = arena_;
+            }
+
+            Attachment(const Attachment&) = delete;
+            Attachment& operator=(const Attachment&) = delete;
+
+            ~Attachment()
+            {
+                current_ = nullptr;
+                arena_->detach();
+            }
+        };
+
+        // memory aligned to 16 bytes - from the calling thread's arena if it has one
+        static void* allocate(size_t size)
+        {
+            if (TaskArena* arena = current_; arena && size <= max_payload_size)
+                return arena->allocate_block(size_class(size));
+
+            auto* block_header = ::new (::operator new(sizeof(Header) + size)) Header{nullptr, 0};
+            return block_header + 1;
+        }
+
+        static void deallocate(void* ptr) noexcept
+        {
+            if (!ptr)
+                return;
+
+            TaskArena* owner = header(ptr)->owner;
+
+            if (!owner)
+                ::operator delete(header(ptr));
+            else if (owner == current_)
+                owner->free_local(ptr);
+            else
+                owner->free_remote(ptr);
+        }
+    };
+} // namespace Detail
+
+#endif // TASK_ARENA_HPP
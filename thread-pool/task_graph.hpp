@@ -0,0 +1,233 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "executor.hpp"
+#include "task.hpp"
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Static dependency graph of tasks - built once, run many times.
+// A node is posted to the executor when its last predecessor completes - no thread waits for a predecessor.
+// After a node throws, the work of nodes not yet started is skipped.
+// Running a prebuilt graph does not allocate (the executor's queue may).
+class TaskGraph
+{
+public:
+    using NodeId = size_t;
+
+private:
+    static constexpr NodeId no_node = static_cast<NodeId>(-1);
+
+    struct Node
+    {
+        Task work;
+        std::vector<NodeId> successors;
+        size_t predecessors_count{};
+        std::atomic<size_t> pending_predecessors{};
+    };
+
+    // posted to the executor - if it is dropped or rejected, the node completes without doing its work
+    // & the run fails with broken_promise
+    class NodeRunner
+    {
+        TaskGraph* graph_;
+        NodeId node_;
+
+    public:
+        NodeRunner(TaskGraph* graph, NodeId node) noexcept
+            : graph_{graph}
+            , node_{node}
+        {
+        }
+
+        NodeRunner(NodeRunner&& other) noexcept
+            : graph_{other.graph_}
+            , node_{std::exchange(other.node_, no_node)}
+        {
+        }
+
+        NodeRunner& operator=(NodeRunner&&) = delete;
+
+        ~NodeRunner()
+        {
+            if (node_ == no_node)
+                return;
+
+            graph_->fail(std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+            graph_->run_node(node_);
+        }
+
+        void operator()()
+        {
+            graph_->run_node(std::exchange(node_, no_node));
+        }
+    };
+
+    std::deque<Node> nodes_; // nodes hold atomics - must not be moved
+    std::vector<NodeId> roots_;
+    bool is_validated_{};
+
+    Executor* executor_{};
+    std::atomic<size_t> remaining_{};
+    std::atomic<bool> has_failed_{};
+    std::exception_ptr exception_;
+    Detail::CompletionFlag done_{true};
+
+    // Kahn's algorithm - throws if the graph has a cycle
+    void validate()
+    {
+        std::vector<size_t> in_degree(nodes_.size());
+        std::vector<NodeId> ready;
+
+        for (NodeId id = 0; id < nodes_.size(); ++id)
+        {
+            in_degree[id] = nodes_[id].predecessors_count;
+            if (in_degree[id] == 0)
+                ready.push_back(id);
+        }
+
+        roots_ = ready;
+
+        size_t visited = 0;
+        while (!ready.empty())
+        {
+            const NodeId id = ready.back();
+            ready.pop_back();
+            ++visited;
+
+            for (NodeId successor : nodes_[id].successors)
+                if (--in_degree[successor] == 0)
+                    ready.push_back(successor);
+        }
+
+        if (visited != nodes_.size())
+            throw std::logic_error{"TaskGraph has a cycle"};
+
+        is_validated_ = true;
+    }
+
+    void fail(std::exception_ptr e)
+    {
+        if (!has_failed_.exchange(true, std::memory_order_acq_rel))
+            exception_ = std::move(e);
+    }
+
+    void dispatch(NodeId id)
+    {
+        executor_->try_post(Task{NodeRunner{this, id}}); // a rejected runner is dropped right here
+    }
+
+    void run_node(NodeId id)
+    {
+        while (id != no_node)
+        {
+            Node& node = nodes_[id];
+
+            if (!has_failed_.load(std::memory_order_acquire))
+            {
+                try
+                {
+                    node.work();
+                }
+                catch (...)
+                {
+                    fail(std::current_exception());
+                }
+            }
+
+            // one ready successor continues on this thread, others are dispatched
+            NodeId next = no_node;
+            for (NodeId successor : node.successors)
+            {
+                if (nodes_[successor].pending_predecessors.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (next != no_node)
+                        dispatch(next);
+                    next = successor;
+                }
+            }
+
+            // the graph may be destroyed as soon as the last node is done
+            if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                done_.set();
+
+            id = next;
+        }
+    }
+
+public:
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    ~TaskGraph()
+    {
+        done_.wait();
+    }
+
+    template <typename Function>
+    NodeId emplace(Function&& f)
+    {
+        auto& node = nodes_.emplace_back();
+        node.work = Task{std::forward<Function>(f)};
+        is_validated_ = false;
+
+        return nodes_.size() - 1;
+    }
+
+    // after must not start before before completes
+    void precede(NodeId before, NodeId after)
+    {
+        nodes_.at(before).successors.push_back(after);
+        ++nodes_.at(after).predecessors_count;
+        is_validated_ = false;
+    }
+
+    size_t size() const
+    {
+        return nodes_.size();
+    }
+
+    // Starts the graph - the graph must not be modified or run again until wait() returns
+    void run(Executor& executor)
+    {
+        if (!done_.is_done())
+            throw std::logic_error{"TaskGraph is already running"};
+
+        if (!is_validated_)
+            validate();
+
+        if (nodes_.empty())
+            return;
+
+        for (auto& node : nodes_)
+            node.pending_predecessors.store(node.predecessors_count, std::memory_order_relaxed);
+
+        executor_ = &executor;
+        exception_ = nullptr;
+        has_failed_.store(false, std::memory_order_relaxed);
+        remaining_.store(nodes_.size(), std::memory_order_relaxed);
+        done_.reset();
+
+        for (NodeId root : roots_)
+            dispatch(root);
+    }
+
+    // Blocks until all nodes are done - rethrows the first exception thrown by a node.
+    // A waiting worker of an executor runs its pending tasks meanwhile - nodes may be queued behind the waiting task.
+    void wait()
+    {
+        done_.wait();
+
+        if (exception_)
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+};
+
+#endif // TASK_GRAPH_HPP
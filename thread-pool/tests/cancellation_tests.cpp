@@ -0,0 +1,134 @@
+#include "catch.hpp"
+#include "future.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <future>
+#include <latch>
+#include <memory>
+#include <stop_token>
+#include <thread>
+
+using namespace std;
+
+TEST_CASE("CancellableFuture")
+{
+    ThreadPool pool{1};
+
+    SECTION("cancel of a pending task completes the future at once & skips the task")
+    {
+        latch release_worker{1};
+        auto blocker = pool.submit([&release_worker] { release_worker.wait(); });
+
+        atomic<bool> is_run{};
+        auto f = pool.submit([&is_run](stop_token) { is_run = true; return 1; });
+
+        REQUIRE(f.cancel());
+        REQUIRE(f.is_ready()); // the worker is still blocked
+
+        release_worker.count_down();
+        blocker.get();
+        pool.submit([] {}).get(); // the skipped task has been popped
+
+        REQUIRE_THROWS_AS(f.get(), TaskCancelledError);
+        REQUIRE_FALSE(is_run);
+    }
+
+    SECTION("cancel of a pending task releases its captures once the task is popped & the future is consumed")
+    {
+        latch release_worker{1};
+        auto blocker = pool.submit([&release_worker] { release_worker.wait(); });
+
+        auto captured = make_shared<int>(1);
+        auto f = pool.submit([captured](stop_token) { return *captured; });
+
+        f.cancel();
+        REQUIRE(captured.use_count() == 2);
+
+        release_worker.count_down();
+        pool.submit([] {}).get();
+
+        REQUIRE_THROWS_AS(f.get(), TaskCancelledError);
+        REQUIRE(captured.use_count() == 1);
+    }
+
+    SECTION("cancel of a running task requests stop - the task decides how to finish")
+    {
+        promise<void> started;
+        auto f = pool.submit([&started](stop_token stop_token) {
+            started.set_value();
+
+            while (!stop_token.stop_requested())
+                this_thread::yield();
+
+            return 42;
+        });
+
+        started.get_future().wait();
+
+        REQUIRE(f.cancel());
+        REQUIRE(f.get() == 42);
+    }
+
+    SECTION("a running task may report cancellation with an exception")
+    {
+        promise<void> started;
+        auto f = pool.submit([&started](stop_token stop_token) -> int {
+            started.set_value();
+
+            while (!stop_token.stop_requested())
+                this_thread::yield();
+
+            throw TaskCancelledError{};
+        });
+
+        started.get_future().wait();
+        f.cancel();
+
+        REQUIRE_THROWS_AS(f.get(), TaskCancelledError);
+    }
+
+    SECTION("cancel after the task completed keeps its result")
+    {
+        auto f = pool.submit([](stop_token) { return 7; });
+        f.wait();
+
+        f.cancel();
+
+        REQUIRE(f.get() == 7);
+    }
+
+    SECTION("second cancel returns false")
+    {
+        auto f = pool.submit([](stop_token) {});
+
+        REQUIRE(f.cancel());
+        REQUIRE_FALSE(f.cancel());
+    }
+}
+
+TEST_CASE("make_cancellable_task")
+{
+    SECTION("a dropped task breaks its promise")
+    {
+        auto [task, f] = make_cancellable_task([](stop_token) { return 1; });
+
+        {
+            Task dropped = std::move(task);
+        }
+
+        REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+
+    SECTION("a cancelled task is not called when run")
+    {
+        bool is_called = false;
+        auto [task, f] = make_cancellable_task([&is_called](stop_token) { is_called = true; });
+
+        f.cancel();
+        task();
+
+        REQUIRE_FALSE(is_called);
+        REQUIRE_THROWS_AS(f.get(), TaskCancelledError);
+    }
+}
@@ -0,0 +1,95 @@
+#include "catch.hpp"
+#include "execution.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("Senders")
+{
+    ThreadPool pool{4};
+    auto scheduler = pool.get_scheduler();
+
+    SECTION("schedule | then | bulk | then - sync_wait returns the final value")
+    {
+        auto result = Exec::sync_wait(scheduler.schedule()
+            | Exec::then([] { return vector<int>(1'001); })
+            | Exec::bulk(1'001, [](int i, vector<int>& values) { values[i] = i; })
+            | Exec::then([](vector<int> values) { return accumulate(values.begin(), values.end(), 0); }));
+
+        REQUIRE(result.has_value());
+        REQUIRE(get<0>(*result) == 1'001 * 1'000 / 2);
+    }
+
+    SECTION("schedule completes on a worker")
+    {
+        auto result = Exec::sync_wait(scheduler.schedule() | Exec::then([] { return this_thread::get_id(); }));
+
+        REQUIRE(get<0>(*result) != this_thread::get_id());
+    }
+
+    SECTION("bulk of a void sender calls f for every index")
+    {
+        vector<atomic<int>> calls(100);
+
+        auto result = Exec::sync_wait(scheduler.schedule() | Exec::bulk(100, [&calls](int i) { ++calls[i]; }));
+
+        REQUIRE(result == tuple<>{});
+        for (auto& count : calls)
+            REQUIRE(count == 1);
+    }
+
+    SECTION("bulk of an empty shape sends the value on")
+    {
+        auto result = Exec::sync_wait(scheduler.schedule()
+            | Exec::then([] { return 42; })
+            | Exec::bulk(0, [](int, int&) { throw logic_error{"not called"}; }));
+
+        REQUIRE(get<0>(*result) == 42);
+    }
+
+    SECTION("an exception thrown in bulk is rethrown by sync_wait & skips the next steps")
+    {
+        atomic<bool> is_then_called{};
+
+        auto sender = scheduler.schedule()
+            | Exec::bulk(1'000, [](int i) {
+                  if (i == 500)
+                      throw runtime_error{"Error#500"};
+              })
+            | Exec::then([&is_then_called] { is_then_called = true; });
+
+        REQUIRE_THROWS_AS(Exec::sync_wait(std::move(sender)), runtime_error);
+        REQUIRE_FALSE(is_then_called);
+    }
+
+    SECTION("an exception thrown in then is rethrown by sync_wait")
+    {
+        auto sender = scheduler.schedule() | Exec::then([]() -> int { throw runtime_error{"Error#13"}; });
+
+        REQUIRE_THROWS_AS(Exec::sync_wait(std::move(sender)), runtime_error);
+    }
+}
+
+// a blocking sync_wait would deadlock - ctest times out
+TEST_CASE("sync_wait on a worker of a single-threaded pool runs the pipeline on the waiting worker")
+{
+    ThreadPool pool{1};
+    auto scheduler = pool.get_scheduler();
+
+    auto f = pool.submit([&scheduler] {
+        auto result = Exec::sync_wait(scheduler.schedule()
+            | Exec::then([] { return vector<int>(10); })
+            | Exec::bulk(10, [](int i, vector<int>& values) { values[i] = i; }));
+
+        return get<0>(*result);
+    });
+
+    REQUIRE(f.get() == vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "coro_task.hpp"
+#include "execution.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <future>
+#include <latch>
+#include <stdexcept>
+
+using namespace std;
+
+TEST_CASE("Executor::try_post")
+{
+    ThreadPool pool{2};
+
+    SECTION("returns an accepted task empty")
+    {
+        promise<void> done;
+
+        REQUIRE_FALSE(pool.try_post(Task{[&done] { done.set_value(); }}));
+        done.get_future().wait();
+    }
+
+    SECTION("returns the task rejected after shutdown - post throws & leaves the task untouched")
+    {
+        pool.shutdown();
+
+        bool is_run = false;
+        Task task{[&is_run] { is_run = true; }};
+
+        REQUIRE_THROWS_AS(pool.post(std::move(task)), runtime_error);
+        REQUIRE(task);
+
+        Task rejected = pool.try_post(std::move(task));
+        REQUIRE(rejected);
+
+        rejected();
+        REQUIRE(is_run);
+    }
+
+    SECTION("a task graph run on a shut down pool completes with broken_promise")
+    {
+        pool.shutdown();
+
+        TaskGraph graph;
+        atomic<int> counter{};
+        graph.precede(graph.emplace([&counter] { ++counter; }), graph.emplace([&counter] { ++counter; }));
+
+        graph.run(pool);
+
+        REQUIRE_THROWS_AS(graph.wait(), future_error);
+        REQUIRE(counter == 0);
+    }
+
+    SECTION("co_await schedule() on a shut down pool resumes with broken_promise")
+    {
+        pool.shutdown();
+
+        auto coroutine = [&pool]() -> Coro::Task<bool> {
+            bool is_dropped = false;
+
+            try
+            {
+                co_await Coro::schedule(pool);
+            }
+            catch (const future_error&)
+            {
+                is_dropped = true;
+            }
+
+            co_return is_dropped;
+        };
+
+        REQUIRE(Coro::sync_wait(coroutine()));
+    }
+
+    SECTION("a sender scheduled on a shut down pool is stopped")
+    {
+        pool.shutdown();
+
+        REQUIRE_FALSE(Exec::sync_wait(pool.get_scheduler().schedule()).has_value());
+    }
+}
+
+TEST_CASE("Executor::try_post under OverflowPolicy::reject returns the task if the queue is full")
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = 1, .max_threads = 1, .queue_capacity = 1, .overflow_policy = OverflowPolicy::reject}};
+
+    latch release_worker{1};
+    promise<void> started;
+    pool.post(Task{[&] {
+        started.set_value();
+        release_worker.wait();
+    }});
+    started.get_future().wait();
+
+    REQUIRE_FALSE(pool.try_post(Task{[] {}})); // fills the queue
+    REQUIRE(pool.try_post(Task{[] {}}));
+
+    release_worker.count_down();
+}
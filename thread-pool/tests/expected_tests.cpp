@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "expected.hpp"
+#include "thread_pool.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+TEST_CASE("Expected")
+{
+    SECTION("holds a value")
+    {
+        Expected<int, string> e{42};
+
+        REQUIRE(e.has_value());
+        REQUIRE(static_cast<bool>(e));
+        REQUIRE(*e == 42);
+        REQUIRE(e.value() == 42);
+        REQUIRE(e.value_or(7) == 42);
+    }
+
+    SECTION("holds an error")
+    {
+        Expected<int, string> e{Unexpected{string{"failed"}}};
+
+        REQUIRE_FALSE(e.has_value());
+        REQUIRE_FALSE(static_cast<bool>(e));
+        REQUIRE(e.error() == "failed");
+        REQUIRE(e.value_or(7) == 7);
+    }
+
+    SECTION("value() of an error throws BadExpectedAccess")
+    {
+        Expected<int, string> e{Unexpected{string{"failed"}}};
+
+        REQUIRE_THROWS_AS(e.value(), BadExpectedAccess<string>);
+
+        try
+        {
+            e.value();
+        }
+        catch (const BadExpectedAccess<string>& ex)
+        {
+            REQUIRE(ex.error() == "failed");
+        }
+
+        Expected<void, string> v{Unexpected{string{"failed"}}};
+        REQUIRE_THROWS_AS(v.value(), BadExpectedAccess<string>);
+        REQUIRE_NOTHROW(Expected<void, string>{}.value());
+    }
+
+    SECTION("copy")
+    {
+        const Expected<string, int> value{string{"text"}};
+        const Expected<string, int> error{Unexpected{13}};
+
+        Expected<string, int> value_copy = value;
+        Expected<string, int> error_copy = error;
+
+        REQUIRE(*value_copy == "text");
+        REQUIRE(*value == "text");
+        REQUIRE(error_copy.error() == 13);
+
+        value_copy = error;
+        REQUIRE(value_copy.error() == 13);
+        error_copy = value;
+        REQUIRE(*error_copy == "text");
+    }
+
+    SECTION("move")
+    {
+        Expected<unique_ptr<int>, unique_ptr<string>> value{make_unique<int>(42)};
+        Expected<unique_ptr<int>, unique_ptr<string>> error{Unexpected{make_unique<string>("failed")}};
+
+        auto moved_value = std::move(value);
+        auto moved_error = std::move(error);
+
+        REQUIRE(**moved_value == 42);
+        REQUIRE(*moved_error.error() == "failed");
+
+        unique_ptr<int> ptr = std::move(moved_value).value();
+        REQUIRE(*ptr == 42);
+    }
+}
+
+TEST_CASE("ThreadPool::try_submit")
+{
+    ThreadPool pool{2};
+
+    SECTION("a value reaches get()")
+    {
+        auto f = pool.try_submit([]() -> Expected<int, string> { return 42; });
+
+        auto result = f.get();
+
+        REQUIRE(result.has_value());
+        REQUIRE(*result == 42);
+    }
+
+    SECTION("an error reaches get() without a throw")
+    {
+        auto f = pool.try_submit([]() -> Expected<int, string> { return Unexpected{string{"failed"}}; });
+
+        Expected<int, string> result{0};
+        REQUIRE_NOTHROW(result = f.get());
+
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(result.error() == "failed");
+    }
+}
@@ -0,0 +1,289 @@
+#include "catch.hpp"
+#include "future.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("Future::then")
+{
+    ThreadPool pool{2};
+
+    SECTION("is called with the result")
+    {
+        auto f = pool.submit([] { return 6; }).then([](int x) { return x * 7; });
+
+        REQUIRE(f.get() == 42);
+    }
+
+    SECTION("chains continuations")
+    {
+        auto f = pool.submit([] { return string{"a"}; })
+                     .then([](string s) { return s + "b"; })
+                     .then([](string s) { return s + "c"; });
+
+        REQUIRE(f.get() == "abc");
+    }
+
+    SECTION("runs after a void task")
+    {
+        int value = 0;
+
+        auto f = pool.submit([&value] { value = 1; }).then([&value] { return value + 1; });
+
+        REQUIRE(f.get() == 2);
+    }
+
+    SECTION("propagates an exception past a continuation taking the value")
+    {
+        bool is_called = false;
+
+        auto f = pool.submit([]() -> int { throw runtime_error{"Error#13"}; }).then([&is_called](int x) {
+            is_called = true;
+            return x;
+        });
+
+        REQUIRE_THROWS_AS(f.get(), runtime_error);
+        REQUIRE_FALSE(is_called);
+    }
+
+    SECTION("passes the ready future to a continuation taking a Future")
+    {
+        auto f = pool.submit([]() -> int { throw runtime_error{"Error#13"}; }).then([](Future<int> ready) {
+            REQUIRE(ready.is_ready());
+
+            try
+            {
+                return ready.get();
+            }
+            catch (const runtime_error&)
+            {
+                return -1;
+            }
+        });
+
+        REQUIRE(f.get() == -1);
+    }
+
+    SECTION("is called inline if the future is ready")
+    {
+        Promise<int> promise;
+        auto f = promise.get_future();
+        promise.set_value(1);
+
+        const auto caller_id = this_thread::get_id();
+        thread::id continuation_id;
+
+        auto f_result = std::move(f).then([&](int x) {
+            continuation_id = this_thread::get_id();
+            return x;
+        });
+
+        REQUIRE(f_result.is_ready());
+        REQUIRE(f_result.get() == 1);
+        REQUIRE(continuation_id == caller_id);
+    }
+}
+
+TEST_CASE("when_all")
+{
+    ThreadPool pool{4};
+
+    SECTION("is ready when all futures are ready")
+    {
+        latch start{1};
+        vector<Future<int>> futures;
+        for (int i = 0; i < 8; ++i)
+            futures.push_back(pool.submit([&start, i] { start.wait(); return i; }));
+
+        auto f_all = when_all(std::move(futures));
+
+        REQUIRE_FALSE(f_all.is_ready());
+
+        start.count_down();
+        auto ready_futures = f_all.get();
+
+        REQUIRE(ready_futures.size() == 8);
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(ready_futures[i].is_ready());
+            REQUIRE(ready_futures[i].get() == i);
+        }
+    }
+
+    SECTION("of futures of different types")
+    {
+        auto f_all = when_all(pool.submit([] { return 1; }), pool.submit([] { return string{"one"}; }), pool.submit([] {}));
+
+        auto [f_int, f_string, f_void] = f_all.get();
+
+        REQUIRE(f_int.get() == 1);
+        REQUIRE(f_string.get() == "one");
+        REQUIRE_NOTHROW(f_void.get());
+    }
+
+    SECTION("keeps exceptions in the yielded futures")
+    {
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([] { return 1; }));
+        futures.push_back(pool.submit([]() -> int { throw runtime_error{"Error#13"}; }));
+
+        auto ready_futures = when_all(std::move(futures)).get();
+
+        REQUIRE(ready_futures[0].get() == 1);
+        REQUIRE_THROWS_AS(ready_futures[1].get(), runtime_error);
+    }
+
+    SECTION("of no futures is ready at once")
+    {
+        auto f_all = when_all(vector<Future<int>>{});
+
+        REQUIRE(f_all.is_ready());
+        REQUIRE(f_all.get().empty());
+    }
+}
+
+TEST_CASE("when_any")
+{
+    ThreadPool pool{4};
+
+    SECTION("yields the index of the first ready future")
+    {
+        latch release_slow{1};
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([&release_slow] { release_slow.wait(); return 0; }));
+        futures.push_back(pool.submit([] { return 1; }));
+
+        auto result = when_any(std::move(futures)).get();
+
+        REQUIRE(result.index == 1);
+        REQUIRE(result.futures.size() == 2);
+        REQUIRE(result.futures[1].get() == 1);
+
+        release_slow.count_down();
+        REQUIRE(result.futures[0].get() == 0);
+    }
+
+    SECTION("yields futures that can be continued with then()")
+    {
+        latch release_slow{1};
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([] { return 1; }));
+        futures.push_back(pool.submit([&release_slow] { release_slow.wait(); return 2; }));
+
+        auto result = when_any(std::move(futures)).get();
+        REQUIRE(result.index == 0);
+
+        auto f_next = std::move(result.futures[1]).then([](int x) { return x * 10; });
+        release_slow.count_down();
+
+        REQUIRE(f_next.get() == 20);
+    }
+
+    SECTION("waits for the next ready future in a loop until all are ready")
+    {
+        constexpr int tasks_count = 64;
+
+        for (int round = 0; round < 20; ++round)
+        {
+            vector<Future<int>> futures;
+            for (int i = 0; i < tasks_count; ++i)
+                futures.push_back(pool.submit([i] {
+                    this_thread::sleep_for(chrono::microseconds{(i * 37) % 200});
+                    return i;
+                }));
+
+            vector<int> results;
+            while (!futures.empty())
+            {
+                auto [index, pending] = when_any(std::move(futures)).get();
+
+                results.push_back(pending[index].get());
+                pending.erase(pending.begin() + index);
+                futures = std::move(pending);
+            }
+
+            sort(results.begin(), results.end());
+            for (int i = 0; i < tasks_count; ++i)
+                REQUIRE(results[i] == i);
+        }
+    }
+
+    SECTION("forwards an exception to the yielded future")
+    {
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([]() -> int { throw runtime_error{"Error#13"}; }));
+
+        auto result = when_any(std::move(futures)).get();
+
+        REQUIRE(result.index == 0);
+        REQUIRE_THROWS_AS(result.futures[0].get(), runtime_error);
+    }
+
+    SECTION("of void futures")
+    {
+        vector<Future<void>> futures;
+        futures.push_back(pool.submit([] {}));
+
+        auto result = when_any(std::move(futures)).get();
+
+        REQUIRE(result.index == 0);
+        REQUIRE_NOTHROW(result.futures[0].get());
+    }
+
+    SECTION("of no futures yields no index")
+    {
+        auto result = when_any(vector<Future<int>>{}).get();
+
+        REQUIRE(result.index == static_cast<size_t>(-1));
+        REQUIRE(result.futures.empty());
+    }
+}
+
+// a blocking get() would deadlock - ctest times out
+TEST_CASE("Future::get on a worker of a single-threaded pool")
+{
+    ThreadPool pool{1};
+
+    SECTION("runs the nested task on the waiting worker")
+    {
+        auto f = pool.submit([&pool] {
+            return pool.submit([] { return 42; }).get();
+        });
+
+        REQUIRE(f.get() == 42);
+    }
+
+    SECTION("is woken by a result set outside of the pool")
+    {
+        Promise<int> promise;
+        auto f_inner = promise.get_future();
+
+        auto f = pool.submit([&f_inner] { return f_inner.get(); });
+
+        this_thread::sleep_for(10ms); // the worker parks - no pending tasks
+        promise.set_value(7);
+
+        REQUIRE(f.get() == 7);
+    }
+}
+
+TEST_CASE("Future::get on a worker of a single-threaded work-stealing pool")
+{
+    WorkStealing::ThreadPool pool{1};
+
+    auto f = pool.submit([&pool] {
+        return pool.submit([] { return 42; }).get();
+    });
+
+    REQUIRE(f.get() == 42);
+}
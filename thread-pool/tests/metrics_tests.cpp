@@ -0,0 +1,53 @@
+#include "catch.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#if THREAD_POOL_METRICS
+TEST_CASE("ThreadPool::stats")
+{
+    ThreadPool pool{4};
+
+    SECTION("counts every completed task")
+    {
+        for (int i = 0; i < 1'000; ++i)
+            pool.submit([] {});
+
+        pool.shutdown(); // a worker records a task after completing its future
+
+        const auto stats = pool.stats();
+
+        REQUIRE(stats.tasks_completed() == 1'000);
+        REQUIRE(stats.execution_time.count() == 1'000);
+        REQUIRE(stats.wait_time.count() == 1'000);
+        REQUIRE(stats.queue_depth.count() == 1'000);
+    }
+
+    SECTION("can be taken while workers record")
+    {
+        atomic<bool> is_done{};
+        jthread reader{[&] {
+            uint64_t last_count = 0;
+            while (!is_done)
+            {
+                const auto count = pool.stats().tasks_completed();
+                REQUIRE(count >= last_count);
+                last_count = count;
+            }
+        }};
+
+        vector<Future<void>> futures;
+        for (int i = 0; i < 10'000; ++i)
+            futures.push_back(pool.submit([] {}));
+
+        for (auto& f : futures)
+            f.get();
+
+        is_done = true;
+    }
+}
+#endif
@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    // sizes include an empty range & sizes not divisible by the chunk count
+    const size_t sizes[] = {0, 1, 2, 7, 1000, 1001};
+
+    const Chunking chunkings[] = {{Chunking::static_chunks}, {Chunking::dynamic_chunks}, {Chunking::dynamic_chunks, 7}};
+
+    vector<int> iota_vector(size_t size)
+    {
+        vector<int> v(size);
+        iota(v.begin(), v.end(), 1);
+        return v;
+    }
+} // namespace
+
+TEST_CASE("parallel_for")
+{
+    ThreadPool pool{3};
+
+    for (size_t size : sizes)
+    {
+        for (Chunking chunking : chunkings)
+        {
+            CAPTURE(size, chunking.mode, chunking.chunk_size);
+
+            vector<int> data = iota_vector(size);
+            vector<int> expected = data;
+            for_each(expected.begin(), expected.end(), [](int& x) { x *= 2; });
+
+            parallel_for(pool, data.begin(), data.end(), [](int& x) { x *= 2; }, chunking);
+
+            REQUIRE(data == expected);
+
+            vector<atomic<int>> visits(size);
+            parallel_for(pool, size_t{0}, size, [&visits](size_t i) { ++visits[i]; }, chunking);
+
+            REQUIRE(all_of(visits.begin(), visits.end(), [](const atomic<int>& v) { return v == 1; }));
+        }
+    }
+}
+
+TEST_CASE("parallel_transform_reduce")
+{
+    ThreadPool pool{3};
+
+    for (size_t size : sizes)
+    {
+        for (Chunking chunking : chunkings)
+        {
+            CAPTURE(size, chunking.mode, chunking.chunk_size);
+
+            const vector<int> data = iota_vector(size);
+            const auto square = [](int x) { return int64_t{x} * x; };
+
+            const auto expected = transform_reduce(data.begin(), data.end(), int64_t{5}, plus<>{}, square);
+
+            REQUIRE(parallel_transform_reduce(pool, data.begin(), data.end(), int64_t{5}, plus<>{}, square, chunking) == expected);
+
+            // concatenation is not commutative - partial results must be combined in order
+            const auto to_string = [](int x) { return std::to_string(x % 10); };
+            const auto expected_text = transform_reduce(data.begin(), data.end(), string{">"}, plus<>{}, to_string);
+
+            REQUIRE(parallel_transform_reduce(pool, data.begin(), data.end(), string{">"}, plus<>{}, to_string, chunking) == expected_text);
+        }
+    }
+}
+
+TEST_CASE("parallel_inclusive_scan")
+{
+    ThreadPool pool{3};
+
+    for (size_t size : sizes)
+    {
+        for (Chunking chunking : chunkings)
+        {
+            CAPTURE(size, chunking.mode, chunking.chunk_size);
+
+            const vector<int> data = iota_vector(size);
+
+            vector<int> expected(size);
+            inclusive_scan(data.begin(), data.end(), expected.begin());
+
+            vector<int> result(size);
+            auto result_end = parallel_inclusive_scan(pool, data.begin(), data.end(), result.begin(), plus<>{}, chunking);
+
+            REQUIRE(result_end == result.end());
+            REQUIRE(result == expected);
+        }
+    }
+}
+
+TEST_CASE("parallel algorithms called from a pool's task")
+{
+    ThreadPool pool{1};
+
+    auto f = pool.submit([&pool] {
+        const vector<int> data = iota_vector(1000);
+        return parallel_transform_reduce(pool, data.begin(), data.end(), 0, plus<>{}, [](int x) { return x; });
+    });
+
+    REQUIRE(f.get() == 500'500);
+}
@@ -0,0 +1,70 @@
+#include "catch.hpp"
+#include "priority_task_queue.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    // runs every queued task - each one appends its label to the trace
+    void drain(PriorityTaskQueue& queue)
+    {
+        Task task;
+        while (queue.try_pop(task))
+            task();
+    }
+} // namespace
+
+TEST_CASE("PriorityTaskQueue")
+{
+    string trace;
+    const auto push = [&trace](PriorityTaskQueue& queue, TaskPriority priority, string label) {
+        queue.push(Task{[&trace, label] { trace += label; }}, priority);
+    };
+
+    SECTION("lanes are drained in priority order - FIFO within a lane")
+    {
+        PriorityTaskQueue queue;
+
+        push(queue, TaskPriority::low, "l1 ");
+        push(queue, TaskPriority::normal, "n1 ");
+        push(queue, TaskPriority::high, "h1 ");
+        push(queue, TaskPriority::low, "l2 ");
+        push(queue, TaskPriority::high, "h2 ");
+        push(queue, TaskPriority::normal, "n2 ");
+
+        drain(queue);
+
+        REQUIRE(trace == "h1 h2 n1 n2 l1 l2 ");
+    }
+
+    SECTION("a low task is served after starvation_limit (16) tasks of higher lanes")
+    {
+        PriorityTaskQueue queue;
+        REQUIRE(PriorityTaskQueue::default_starvation_limit == 16);
+
+        push(queue, TaskPriority::low, "l");
+        for (int i = 0; i < 20; ++i)
+            push(queue, TaskPriority::high, "h");
+
+        drain(queue);
+
+        REQUIRE(trace == string(16, 'h') + "l" + string(4, 'h'));
+    }
+
+    SECTION("every starving lane gets its turn")
+    {
+        PriorityTaskQueue queue{2};
+
+        push(queue, TaskPriority::low, "l");
+        push(queue, TaskPriority::normal, "n");
+        for (int i = 0; i < 6; ++i)
+            push(queue, TaskPriority::high, "h");
+
+        drain(queue);
+
+        REQUIRE(trace == "hhnlhhhh"); // the low lane was skipped by the normal task too
+    }
+}
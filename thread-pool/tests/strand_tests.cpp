@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "strand.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("Strand")
+{
+    ThreadPool pool{4};
+
+    SECTION("runs tasks posted by one thread in FIFO order")
+    {
+        Strand strand{pool, 8};
+        vector<int> order;
+
+        vector<Future<void>> futures;
+        for (int i = 0; i < 1'000; ++i)
+            futures.push_back(strand.submit([&order, i] { order.push_back(i); }));
+
+        for (auto& f : futures)
+            f.get();
+
+        REQUIRE(order.size() == 1'000);
+        for (int i = 0; i < 1'000; ++i)
+            REQUIRE(order[i] == i);
+    }
+
+    SECTION("keeps the order of every producer when many threads post")
+    {
+        constexpr int producers_count = 4;
+        constexpr int tasks_per_producer = 2'000;
+
+        Strand strand{pool, 16};
+        vector<vector<int>> received(producers_count);
+        atomic<int> done_count{};
+        promise<void> all_done;
+
+        vector<jthread> producers;
+        for (int p = 0; p < producers_count; ++p)
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < tasks_per_producer; ++i)
+                    strand.post([&, p, i] {
+                        received[p].push_back(i);
+                        if (++done_count == producers_count * tasks_per_producer)
+                            all_done.set_value();
+                    });
+            });
+
+        all_done.get_future().wait();
+
+        for (const auto& sequence : received)
+        {
+            REQUIRE(sequence.size() == tasks_per_producer);
+            for (int i = 0; i < tasks_per_producer; ++i)
+                REQUIRE(sequence[i] == i);
+        }
+    }
+
+    SECTION("never runs two of its tasks at once")
+    {
+        Strand strand{pool, 4};
+        atomic<int> running{};
+        atomic<int> max_running{};
+        int unsynchronized_counter = 0;
+
+        vector<Future<void>> futures;
+        for (int i = 0; i < 2'000; ++i)
+            futures.push_back(strand.submit([&] {
+                const int now_running = ++running;
+                max_running = max(max_running.load(), now_running);
+                ++unsynchronized_counter;
+                this_thread::yield();
+                --running;
+            }));
+
+        for (auto& f : futures)
+            f.get();
+
+        REQUIRE(max_running == 1);
+        REQUIRE(unsynchronized_counter == 2'000);
+    }
+
+    SECTION("runs different strands in parallel")
+    {
+        Strand first{pool};
+        Strand second{pool};
+        promise<void> first_started;
+        promise<void> second_started;
+
+        auto f1 = first.submit([&] {
+            first_started.set_value();
+            second_started.get_future().wait();
+        });
+        auto f2 = second.submit([&] {
+            second_started.set_value();
+            first_started.get_future().wait();
+        });
+
+        f1.get();
+        f2.get();
+    }
+
+    SECTION("running_in_this_thread() is true only inside its tasks")
+    {
+        Strand strand{pool};
+
+        REQUIRE_FALSE(strand.running_in_this_thread());
+        REQUIRE(strand.submit([&strand] { return strand.running_in_this_thread(); }).get());
+    }
+}
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "task_arena.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Detail::TaskArena;
+
+namespace
+{
+    bool is_aligned(void* ptr)
+    {
+        return reinterpret_cast<uintptr_t>(ptr) % 16 == 0;
+    }
+} // namespace
+
+TEST_CASE("TaskArena")
+{
+    SECTION("reuses a block freed by the owner")
+    {
+        TaskArena::Attachment attachment;
+
+        void* block = TaskArena::allocate(100);
+        TaskArena::deallocate(block);
+
+        REQUIRE(TaskArena::allocate(100) == block);
+        TaskArena::deallocate(block);
+    }
+
+    SECTION("returns 16-byte aligned blocks of every size class & above")
+    {
+        TaskArena::Attachment attachment;
+
+        for (size_t size : {1, 64, 65, 200, 512, 513, 4096})
+        {
+            void* block = TaskArena::allocate(size);
+            memset(block, 0xAB, size);
+
+            REQUIRE(is_aligned(block));
+
+            TaskArena::deallocate(block);
+        }
+    }
+
+    SECTION("uses the global allocator on a thread without an arena")
+    {
+        void* block = TaskArena::allocate(64);
+        memset(block, 0xAB, 64);
+
+        REQUIRE(is_aligned(block));
+
+        TaskArena::deallocate(block);
+    }
+
+    SECTION("takes back blocks freed by other threads")
+    {
+        TaskArena::Attachment attachment;
+
+        vector<void*> blocks;
+        for (int i = 0; i < 100; ++i)
+            blocks.push_back(TaskArena::allocate(48));
+
+        thread{[&blocks] {
+            for (void* block : blocks)
+                TaskArena::deallocate(block);
+        }}.join();
+
+        // the free list is empty - the owner reclaims the remote frees
+        vector<void*> reused;
+        for (int i = 0; i < 100; ++i)
+            reused.push_back(TaskArena::allocate(48));
+
+        sort(blocks.begin(), blocks.end());
+        sort(reused.begin(), reused.end());
+        REQUIRE(reused == blocks);
+
+        for (void* block : reused)
+            TaskArena::deallocate(block);
+    }
+
+    SECTION("keeps blocks valid after the owner exits - the last free releases the arena")
+    {
+        vector<char*> blocks;
+
+        thread{[&blocks] {
+            TaskArena::Attachment attachment;
+
+            for (int i = 0; i < 1'000; ++i)
+            {
+                auto* block = static_cast<char*>(TaskArena::allocate(128));
+                memset(block, i % 128, 128);
+                blocks.push_back(block);
+            }
+
+            TaskArena::deallocate(blocks.back()); // some blocks freed by the owner
+            blocks.pop_back();
+        }}.join();
+
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            REQUIRE(blocks[i][0] == static_cast<char>(i % 128));
+            REQUIRE(blocks[i][127] == static_cast<char>(i % 128));
+            TaskArena::deallocate(blocks[i]);
+        }
+    }
+
+    SECTION("releases the arena of an owner exiting with no live blocks")
+    {
+        thread{[] {
+            TaskArena::Attachment attachment;
+            TaskArena::deallocate(TaskArena::allocate(64));
+        }}.join();
+    }
+}
+
+TEST_CASE("Futures of tasks submitted by a worker outlive the pool")
+{
+    vector<Future<vector<int>>> futures;
+
+    {
+        ThreadPool pool{ThreadPoolOptions{.min_threads = 2, .max_threads = 2, .task_arenas = true}};
+
+        futures = pool.submit([&pool] {
+                          vector<Future<vector<int>>> inner;
+                          for (int i = 0; i < 100; ++i)
+                              inner.push_back(pool.submit([i] { return vector<int>(10, i); }));
+                          return inner;
+                      })
+                      .get();
+
+        for (auto& f : futures)
+            f.wait();
+    }
+
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(futures[i].get() == vector<int>(10, i));
+}
@@ -0,0 +1,117 @@
+#include "catch.hpp"
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("TaskGraph")
+{
+    ThreadPool pool{4};
+    TaskGraph graph;
+
+    SECTION("runs a node after all its predecessors")
+    {
+        mutex mtx;
+        vector<int> order;
+        auto record = [&](int id) {
+            return [&, id] {
+                lock_guard lk{mtx};
+                order.push_back(id);
+            };
+        };
+
+        // diamond: 0 -> {1, 2} -> 3
+        const auto a = graph.emplace(record(0));
+        const auto b = graph.emplace(record(1));
+        const auto c = graph.emplace(record(2));
+        const auto d = graph.emplace(record(3));
+        graph.precede(a, b);
+        graph.precede(a, c);
+        graph.precede(b, d);
+        graph.precede(c, d);
+
+        for (int run = 0; run < 100; ++run)
+        {
+            order.clear();
+
+            graph.run(pool);
+            graph.wait();
+
+            REQUIRE(order.size() == 4);
+            REQUIRE(order.front() == 0);
+            REQUIRE(order.back() == 3);
+        }
+    }
+
+    SECTION("rethrows the first exception from wait() & skips nodes not yet started")
+    {
+        atomic<bool> is_successor_run{};
+
+        const auto failing = graph.emplace([] { throw runtime_error{"Error#13"}; });
+        const auto successor = graph.emplace([&] { is_successor_run = true; });
+        graph.precede(failing, successor);
+
+        graph.run(pool);
+
+        REQUIRE_THROWS_AS(graph.wait(), runtime_error);
+        REQUIRE_FALSE(is_successor_run);
+    }
+
+    SECTION("rejects a cycle")
+    {
+        const auto a = graph.emplace([] {});
+        const auto b = graph.emplace([] {});
+        graph.precede(a, b);
+        graph.precede(b, a);
+
+        REQUIRE_THROWS_AS(graph.run(pool), logic_error);
+    }
+}
+
+// a blocking wait would deadlock - ctest times out
+TEST_CASE("TaskGraph waited for by a task of a single-threaded pool")
+{
+    ThreadPool pool{1};
+
+    auto make_graph = [](TaskGraph& graph, atomic<int>& counter) {
+        const auto first = graph.emplace([&counter] { ++counter; });
+        for (int i = 0; i < 10; ++i)
+            graph.precede(first, graph.emplace([&counter] { ++counter; }));
+    };
+
+    SECTION("wait() runs the graph's nodes on the waiting worker")
+    {
+        auto f = pool.submit([&pool, &make_graph] {
+            atomic<int> counter{};
+            TaskGraph graph;
+            make_graph(graph, counter);
+
+            graph.run(pool);
+            graph.wait();
+
+            return counter.load();
+        });
+
+        REQUIRE(f.get() == 11);
+    }
+
+    SECTION("destructor waits without blocking the worker")
+    {
+        atomic<int> counter{};
+
+        auto f = pool.submit([&pool, &make_graph, &counter] {
+            TaskGraph graph;
+            make_graph(graph, counter);
+
+            graph.run(pool);
+        });
+
+        f.get();
+        REQUIRE(counter == 11);
+    }
+}
@@ -0,0 +1,196 @@
+#include "catch.hpp"
+#include "future.hpp"
+#include "task.hpp"
+
+#include <array>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+    // closure counting its heap allocations - Task allocates it with new
+    template <size_t Size>
+    struct CountingCallable
+    {
+        inline static int allocations_count = 0;
+
+        array<std::byte, Size> payload{};
+        const void** address;
+
+        explicit CountingCallable(const void** address)
+            : address{address}
+        {
+        }
+
+        CountingCallable(CountingCallable&&) noexcept = default;
+
+        void operator()()
+        {
+            *address = this;
+        }
+
+        static void* operator new(size_t size)
+        {
+            ++allocations_count;
+            return ::operator new(size);
+        }
+
+        static void operator delete(void* ptr) noexcept
+        {
+            ::operator delete(ptr);
+        }
+    };
+
+    bool is_inside(const void* ptr, const Task& task)
+    {
+        const auto* first = reinterpret_cast<const std::byte*>(&task);
+        const auto* p = static_cast<const std::byte*>(ptr);
+
+        return first <= p && p < first + sizeof(Task);
+    }
+} // namespace
+
+TEST_CASE("Task")
+{
+    const void* address = nullptr;
+
+    SECTION("is empty after default construction")
+    {
+        Task task;
+
+        REQUIRE_FALSE(task);
+    }
+
+    SECTION("stores a small closure inline")
+    {
+        using Small = CountingCallable<Task::small_buffer_size - sizeof(void*)>;
+        Small::allocations_count = 0;
+
+        Task task{Small{&address}};
+        task();
+
+        REQUIRE(Small::allocations_count == 0);
+        REQUIRE(is_inside(address, task));
+    }
+
+    SECTION("stores a closure above small_buffer_size on the heap")
+    {
+        using Large = CountingCallable<Task::small_buffer_size>;
+        Large::allocations_count = 0;
+
+        Task task{Large{&address}};
+        task();
+
+        REQUIRE(Large::allocations_count == 1);
+        REQUIRE_FALSE(is_inside(address, task));
+    }
+
+    SECTION("moves an inline closure into the target")
+    {
+        Task source{CountingCallable<8>{&address}};
+        Task target{std::move(source)};
+
+        target();
+
+        REQUIRE_FALSE(source);
+        REQUIRE(is_inside(address, target));
+    }
+
+    SECTION("keeps a heap closure in place when moved")
+    {
+        Task source{CountingCallable<Task::small_buffer_size>{&address}};
+        source();
+        const void* heap_address = address;
+
+        Task target;
+        target = std::move(source);
+        target();
+
+        REQUIRE_FALSE(source);
+        REQUIRE(address == heap_address);
+    }
+
+    SECTION("accepts move-only callables")
+    {
+        auto value = make_unique<int>(42);
+        int result = 0;
+
+        Task task{[value = std::move(value), &result] { result = *value; }};
+        Task moved = std::move(task);
+        moved();
+
+        REQUIRE(result == 42);
+    }
+
+    SECTION("destroys the closure with the task")
+    {
+        auto value = make_shared<int>(1);
+
+        {
+            Task task{[value] {}};
+            REQUIRE(value.use_count() == 2);
+        }
+
+        REQUIRE(value.use_count() == 1);
+    }
+}
+
+TEST_CASE("make_task")
+{
+    SECTION("sets the future's value when the task runs")
+    {
+        auto [task, f] = make_task([] { return 42; });
+
+        REQUIRE_FALSE(f.is_ready());
+
+        task();
+
+        REQUIRE(f.is_ready());
+        REQUIRE(f.get() == 42);
+    }
+
+    SECTION("accepts move-only callables & results")
+    {
+        auto [task, f] = make_task([value = make_unique<int>(13)]() mutable { return std::move(value); });
+
+        task();
+
+        REQUIRE(*f.get() == 13);
+    }
+
+    SECTION("propagates an exception to the future")
+    {
+        auto [task, f] = make_task([]() -> int { throw runtime_error{"Error#13"}; });
+
+        task();
+
+        REQUIRE_THROWS_AS(f.get(), runtime_error);
+    }
+
+    SECTION("breaks the promise if the task is dropped without running")
+    {
+        auto [task, f] = make_task([] { return 42; });
+
+        {
+            Task dropped = std::move(task);
+        }
+
+        REQUIRE(f.is_ready());
+
+        try
+        {
+            f.get();
+            FAIL("future_error expected");
+        }
+        catch (const future_error& e)
+        {
+            REQUIRE(e.code() == future_errc::broken_promise);
+        }
+    }
+}
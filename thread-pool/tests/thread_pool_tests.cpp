@@ -0,0 +1,262 @@
+#include "catch.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    // sets released once shutdown() has closed the queue - a submit from outside throws then
+    jthread release_on_close(ThreadPool& pool, atomic<bool>& released)
+    {
+        return jthread{[&pool, &released] {
+            try
+            {
+                while (true)
+                {
+                    pool.submit([] { });
+                    this_thread::sleep_for(1ms);
+                }
+            }
+            catch (const runtime_error&)
+            {
+            }
+
+            released = true;
+            released.notify_all();
+        }};
+    }
+
+    // polls condition until it holds or the timeout expires - returns its last result
+    template <typename Condition>
+    bool eventually(Condition condition, chrono::milliseconds timeout = 5s)
+    {
+        const auto deadline = chrono::steady_clock::now() + timeout;
+
+        while (!condition())
+        {
+            if (chrono::steady_clock::now() > deadline)
+                return false;
+            this_thread::sleep_for(1ms);
+        }
+
+        return true;
+    }
+} // namespace
+
+TEST_CASE("ThreadPool::shutdown")
+{
+    ThreadPool pool{1};
+
+    atomic<bool> released{};
+    auto releaser = release_on_close(pool, released);
+
+    // the only worker is busy until shutdown() starts - the tasks below are still queued then
+    pool.submit([&released] { released.wait(false); });
+
+    SECTION("drain runs all queued tasks & their follow-up tasks")
+    {
+        atomic<int> counter{};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&pool, &counter] {
+                ++counter;
+                pool.submit([&counter] { ++counter; });
+            });
+        }
+
+        pool.shutdown(ShutdownMode::drain);
+
+        REQUIRE(counter == 200);
+    }
+
+    SECTION("cancel_pending breaks the promises of queued tasks")
+    {
+        atomic<int> counter{};
+        vector<Future<void>> futures;
+
+        for (int i = 0; i < 100; ++i)
+            futures.push_back(pool.submit([&counter] { ++counter; }));
+
+        pool.shutdown(ShutdownMode::cancel_pending);
+
+        REQUIRE(counter == 0);
+        for (auto& f : futures)
+            REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+
+    SECTION("submit after shutdown throws")
+    {
+        pool.shutdown();
+
+        REQUIRE_THROWS_AS(pool.submit([] { }), runtime_error);
+    }
+}
+
+TEST_CASE("ThreadPool - overflow policy")
+{
+    auto options = ThreadPoolOptions{.min_threads = 1, .max_threads = 1, .queue_capacity = 2};
+
+    atomic<bool> started{};
+    atomic<bool> released{};
+    atomic<int> counter{};
+
+    const auto block_worker = [&](ThreadPool& pool) {
+        pool.submit([&] {
+            started = true;
+            started.notify_all();
+            released.wait(false);
+        });
+        started.wait(false);
+
+        pool.submit([&counter] { ++counter; });
+        pool.submit([&counter] { ++counter; }); // the queue is full now
+    };
+
+    const auto release_worker = [&] {
+        released = true;
+        released.notify_all();
+    };
+
+    SECTION("block - a submitter waits for space")
+    {
+        options.overflow_policy = OverflowPolicy::block;
+        ThreadPool pool{options};
+        block_worker(pool);
+
+        atomic<bool> submitted{};
+        jthread submitter{[&] {
+            pool.submit([&counter] { ++counter; });
+            submitted = true;
+        }};
+
+        this_thread::sleep_for(50ms);
+        REQUIRE_FALSE(submitted);
+
+        release_worker();
+        submitter.join();
+        pool.shutdown();
+
+        REQUIRE(submitted);
+        REQUIRE(counter == 3);
+    }
+
+    SECTION("block - a pool's task runs its submit inline")
+    {
+        options.overflow_policy = OverflowPolicy::block;
+        ThreadPool pool{options};
+
+        auto f = pool.submit([&pool] {
+            pool.submit([] { });
+            pool.submit([] { }); // the queue is full now
+
+            return pool.submit([] { return this_thread::get_id(); }).get() == this_thread::get_id();
+        });
+
+        REQUIRE(f.get());
+    }
+
+    SECTION("reject - submit throws QueueFullError")
+    {
+        options.overflow_policy = OverflowPolicy::reject;
+        ThreadPool pool{options};
+        block_worker(pool);
+
+        REQUIRE_THROWS_AS(pool.submit([&counter] { ++counter; }), QueueFullError);
+
+        release_worker();
+        pool.shutdown();
+
+        REQUIRE(counter == 2);
+    }
+
+    SECTION("run_inline - the submitter runs the task")
+    {
+        options.overflow_policy = OverflowPolicy::run_inline;
+        ThreadPool pool{options};
+        block_worker(pool);
+
+        auto f = pool.submit([] { return this_thread::get_id(); });
+
+        REQUIRE(f.get() == this_thread::get_id());
+
+        release_worker();
+        pool.shutdown();
+
+        REQUIRE(counter == 2);
+    }
+}
+
+TEST_CASE("ThreadPool - elastic size")
+{
+    ThreadPool pool{ThreadPoolOptions{.min_threads = 1, .max_threads = 4, .idle_timeout = 50ms, .grow_queue_depth = 2}};
+
+    REQUIRE(pool.size() == 1);
+
+    atomic<bool> released{};
+    atomic<size_t> running{};
+    atomic<size_t> max_running{};
+    vector<Future<void>> futures;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        futures.push_back(pool.submit([&] {
+            const size_t now_running = ++running;
+            size_t previous_max = max_running;
+            while (previous_max < now_running && !max_running.compare_exchange_weak(previous_max, now_running))
+                ;
+
+            released.wait(false);
+            --running;
+        }));
+    }
+
+    // grows under queue depth up to max_threads
+    REQUIRE(pool.size() == 4);
+    REQUIRE(eventually([&] { return running == 4; }));
+
+    released = true;
+    released.notify_all();
+
+    for (auto& f : futures)
+        f.get();
+
+    REQUIRE(max_running == 4);
+
+    // retires workers idle for idle_timeout down to min_threads
+    REQUIRE(eventually([&] { return pool.size() == 1; }));
+}
+
+TEST_CASE("ThreadPool::BlockingRegion")
+{
+    ThreadPool pool{1};
+
+    atomic<bool> released{};
+    atomic<size_t> size_while_blocked{};
+
+    // the only worker blocks until a task queued behind it runs - without a compensating worker it would deadlock - ctest times out
+    auto blocked = pool.submit([&] {
+        auto region = pool.blocking_region();
+        released.wait(false);
+    });
+
+    pool.submit([&] {
+        size_while_blocked = pool.size();
+        released = true;
+        released.notify_all();
+    });
+
+    blocked.get();
+
+    REQUIRE(size_while_blocked == 2);
+
+    // the surplus worker retires once the blocked task has finished
+    REQUIRE(eventually([&] { return pool.size() == 1; }));
+}
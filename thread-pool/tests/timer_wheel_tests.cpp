@@ -0,0 +1,180 @@
+#include "catch.hpp"
+#include "future.hpp"
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::literals;
+
+TEST_CASE("TimerWheel")
+{
+    using Detail::TimerWheel;
+
+    TimerWheel wheel;
+    map<uint32_t, uint64_t> expired_at; // timer index -> tick
+
+    auto arm = [&wheel](uint64_t deadline) {
+        auto& timer = wheel.allocate(Task{[] {}}, 0);
+        wheel.link(timer, deadline);
+        return timer.index;
+    };
+
+    auto advance_tick_by_tick = [&](uint64_t tick) {
+        while (wheel.current_tick() < tick)
+            wheel.advance(wheel.current_tick() + 1, [&](TimerWheel::Timer& timer) {
+                expired_at[timer.index] = wheel.current_tick();
+                wheel.release(timer);
+            });
+    };
+
+    SECTION("places timers on levels by distance to the deadline")
+    {
+        REQUIRE(wheel[arm(63)].level == 0);
+        REQUIRE(wheel[arm(64)].level == 1);
+        REQUIRE(wheel[arm(64 * 64 - 1)].level == 1);
+        REQUIRE(wheel[arm(64 * 64)].level == 2);
+        REQUIRE(wheel[arm(64 * 64 * 64)].level == 3);
+        REQUIRE(wheel.size() == 5);
+    }
+
+    SECTION("cascades timers down through all levels & fires them at their deadlines")
+    {
+        const vector<uint64_t> deadlines{1, 63, 64, 65, 130, 4095, 4096, 4097, 70'000, 262'143, 262'144, 300'007};
+
+        map<uint32_t, uint64_t> deadline_of;
+        for (auto deadline : deadlines)
+            deadline_of[arm(deadline)] = deadline;
+
+        advance_tick_by_tick(deadlines.back());
+
+        REQUIRE(wheel.empty());
+        REQUIRE(expired_at == deadline_of);
+    }
+
+    SECTION("fires cascaded timers when advanced by many ticks at once")
+    {
+        const auto early = arm(100);
+        const auto late = arm(5'000);
+
+        vector<uint32_t> order;
+        wheel.advance(10'000, [&](TimerWheel::Timer& timer) {
+            order.push_back(timer.index);
+            wheel.release(timer);
+        });
+
+        REQUIRE(order == vector<uint32_t>{early, late});
+        REQUIRE(wheel.current_tick() == 10'000);
+    }
+
+    SECTION("does not fire an unlinked timer")
+    {
+        const auto kept = arm(200);
+        const auto removed = arm(300);
+
+        wheel.unlink(wheel[removed]);
+        wheel.release(wheel[removed]);
+
+        advance_tick_by_tick(400);
+
+        REQUIRE(expired_at.size() == 1);
+        REQUIRE(expired_at.count(kept) == 1);
+    }
+
+    SECTION("invalidates handles of a released timer")
+    {
+        const auto index = arm(10);
+        const auto generation = wheel[index].generation;
+
+        REQUIRE(wheel.find(index, generation) != nullptr);
+
+        advance_tick_by_tick(10);
+
+        REQUIRE(wheel.find(index, generation) == nullptr);
+    }
+}
+
+TEST_CASE("TimerService")
+{
+    ThreadPool pool{2};
+    TimerService timers{pool};
+
+    SECTION("runs a task after the delay")
+    {
+        promise<chrono::steady_clock::time_point> fired;
+        const auto start = chrono::steady_clock::now();
+
+        timers.post_after(20ms, [&fired] { fired.set_value(chrono::steady_clock::now()); });
+
+        REQUIRE(fired.get_future().get() - start >= 20ms);
+    }
+
+    SECTION("cancel before the timer fires drops the task")
+    {
+        atomic<bool> is_run{};
+
+        auto handle = timers.post_after(200ms, [&is_run] { is_run = true; });
+
+        REQUIRE(handle.cancel());
+        REQUIRE(timers.size() == 0);
+        REQUIRE_FALSE(handle.cancel());
+
+        this_thread::sleep_for(300ms);
+        REQUIRE_FALSE(is_run);
+    }
+
+    SECTION("cancel of a dropped submit_after task breaks its promise")
+    {
+        auto [task, f] = make_task([] { return 1; });
+        auto handle = timers.post_after(200ms, std::move(task));
+
+        REQUIRE(handle.cancel());
+        REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+
+    SECTION("cancel after a one-shot timer fired returns false")
+    {
+        auto [task, f] = make_task([] { return 1; });
+        auto handle = timers.post_after(1ms, std::move(task));
+
+        REQUIRE(f.get() == 1);
+        REQUIRE_FALSE(handle.cancel());
+    }
+
+    SECTION("cancel stops a periodic timer after it fired")
+    {
+        atomic<int> runs_count{};
+
+        auto handle = timers.post_every(2ms, [&runs_count] { ++runs_count; });
+
+        while (runs_count < 3)
+            this_thread::sleep_for(1ms);
+
+        REQUIRE(handle.cancel());
+        REQUIRE_FALSE(handle.cancel());
+
+        this_thread::sleep_for(20ms); // a run in progress completes
+        const int runs_after_cancel = runs_count;
+        this_thread::sleep_for(50ms);
+
+        REQUIRE(runs_count == runs_after_cancel);
+    }
+}
+
+TEST_CASE("ThreadPool::submit_after")
+{
+    ThreadPool pool{2};
+
+    const auto start = chrono::steady_clock::now();
+    auto f = pool.submit_after(10ms, [] { return 42; });
+
+    REQUIRE(f.get() == 42);
+    REQUIRE(chrono::steady_clock::now() - start >= 10ms);
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("WorkStealing::ThreadPool")
+{
+    SECTION("runs tasks submitted from outside & from its workers")
+    {
+        atomic<int> counter{};
+
+        {
+            WorkStealing::ThreadPool pool{4};
+
+            vector<Future<void>> futures;
+            for (int i = 0; i < 100; ++i)
+                futures.push_back(pool.submit([&pool, &counter] {
+                    vector<Future<void>> nested;
+                    for (int j = 0; j < 100; ++j)
+                        nested.push_back(pool.submit([&counter] { ++counter; }));
+
+                    for (auto& f : nested)
+                        f.get();
+                }));
+
+            for (auto& f : futures)
+                f.get();
+
+            REQUIRE(counter == 100 * 100);
+        }
+    }
+
+    SECTION("destructor runs all queued tasks")
+    {
+        atomic<int> counter{};
+
+        {
+            WorkStealing::ThreadPool pool{2};
+
+            for (int i = 0; i < 10'000; ++i)
+                pool.post([&counter] { ++counter; });
+        }
+
+        REQUIRE(counter == 10'000);
+    }
+
+    SECTION("a parked worker is woken by a single task")
+    {
+        WorkStealing::ThreadPool pool{4};
+
+        for (int i = 0; i < 1'000; ++i)
+            REQUIRE(pool.submit([i] { return i; }).get() == i);
+    }
+}
@@ -0,0 +1,58 @@
+#include "catch.hpp"
+#include "thread_pool.hpp"
+#include "worker_local.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+TEST_CASE("WorkerLocal")
+{
+    ThreadPool pool{4};
+
+    SECTION("every worker gets its own value")
+    {
+        // created by the worker that calls local() first
+        WorkerLocal<thread::id> owners{pool, [](size_t) { return this_thread::get_id(); }};
+        WorkerLocal<size_t> slots{pool, [](size_t slot) { return slot; }};
+
+        vector<Future<bool>> futures;
+        for (int i = 0; i < 1'000; ++i)
+        {
+            futures.push_back(pool.submit([&] {
+                return owners.local() == this_thread::get_id() && slots.local() == pool.worker_slot();
+            }));
+        }
+
+        for (auto& f : futures)
+            REQUIRE(f.get());
+    }
+
+    SECTION("combine_all merges the values of all workers")
+    {
+        WorkerLocal<uint64_t> partial_sums{pool};
+
+        vector<Future<void>> futures;
+        for (uint64_t i = 1; i <= 1'000; ++i)
+            futures.push_back(pool.submit([&partial_sums, i] { partial_sums.local() += i; }));
+
+        for (auto& f : futures)
+            f.get();
+
+        REQUIRE(partial_sums.combine_all(uint64_t{}, plus<>{}) == 500'500);
+
+        partial_sums.clear();
+        REQUIRE(partial_sums.combine_all(uint64_t{}, plus<>{}) == 0);
+    }
+
+    SECTION("local() outside of the pool's workers throws")
+    {
+        WorkerLocal<int> value{pool};
+
+        REQUIRE_THROWS_AS(value.local(), logic_error);
+    }
+}
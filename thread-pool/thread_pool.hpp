@@ -0,0 +1,885 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "coro_task.hpp"
+#include "cpu_topology.hpp"
+#include "event_count.hpp"
+#include "execution.hpp"
+#include "executor.hpp"
+#include "expected.hpp"
+#include "future.hpp"
+#include "idle_strategy.hpp"
+#include "priority_task_queue.hpp"
+#include "task.hpp"
+#include "task_arena.hpp"
+#include "thread_pool_metrics.hpp"
+#include "thread_pool_trace.hpp"
+#include "thread_safe_queue.hpp"
+#include "timer_wheel.hpp"
+#include "work_stealing_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace PoisoningPill
+{
+    class ThreadPool
+    {
+        ThreadSafeQueue<Task> tasks_;
+        std::vector<std::jthread> threads_;
+
+        void run()
+        {
+            while (true)
+            {
+                Task task;
+                tasks_.pop(task);
+                if (!task)
+                    break;
+                task();
+            }
+        }
+
+    public:
+        ThreadPool(size_t size = std::thread::hardware_concurrency())
+            : threads_(size)
+        {
+            for (auto& thd : threads_)
+                thd = std::jthread{[this] {
+                    run();
+                }};
+        }
+
+        ~ThreadPool()
+        {
+            for (size_t i = 0; i < threads_.size(); ++i)
+                tasks_.push(Task{}); // EndOfWork
+
+            for (auto& thd : threads_)
+                thd.join();
+        }
+
+        void submit(Task task)
+        {
+            if (!task)
+                throw std::invalid_argument{"Empty task not allowed"};
+
+            tasks_.push(std::move(task));
+        }
+    };
+
+} // namespace PoisoningPill
+
+enum class ShutdownMode
+{
+    drain, // queued tasks (and follow-up tasks they submit) are run before workers exit
+    cancel_pending // workers exit after their current task, queued tasks are dropped (their futures get broken_promise)
+};
+
+enum class OverflowPolicy
+{
+    block, // the submitter waits for space - a pool's own task runs the new task inline instead, blocking it could deadlock the pool
+    reject, // submit throws QueueFullError
+    run_inline // the submitter runs the task itself
+};
+
+struct ThreadPoolOptions
+{
+    size_t min_threads = std::max(1u, std::thread::hardware_concurrency()); // hardware_concurrency() may be 0
+    size_t max_threads = min_threads;
+    std::chrono::milliseconds idle_timeout{1000}; // workers above min_threads retire after being idle that long
+    size_t grow_queue_depth = 4; // grow when at least that many tasks are queued & no worker is idle...
+    std::chrono::milliseconds grow_wait_time{10}; // ...or when a task has waited in the queue longer than that
+    WorkerPlacement placement = WorkerPlacement::none; // pinned workers prefer their NUMA node for allocations
+    IdleStrategy idle_strategy{}; // e.g. {.max_spin_time = 50us, .yield_count = 16} - parks right away by default
+    size_t queue_capacity = PriorityTaskQueue::unbounded; // at most that many tasks are queued...
+    OverflowPolicy overflow_policy = OverflowPolicy::block; // ...a submit to the full queue is handled by the policy
+    size_t trace_buffer_size = 0; // last task spans kept per worker for dump_trace() - 0: tracing off
+    size_t max_blocking_threads = 256; // compensating workers allowed above max_threads while tasks block (see blocking_region())
+    bool task_arenas = true; // task states submitted from a worker come from its slab arena instead of the global allocator
+};
+
+class ThreadPool : public Executor
+{
+    using Workers = std::list<std::jthread>;
+
+    const ThreadPoolOptions options_;
+    const CpuPlacement placement_;
+    PriorityTaskQueue tasks_;
+    std::atomic<size_t> threads_count_{};
+    std::atomic<size_t> blocked_count_{}; // workers inside a blocking region - each one may be compensated by a new worker
+    mutable std::mutex mtx_workers_; // guards workers_, used_slots_, metrics_, traces_, retired_workers_ & is_shutting_down_ - never taken on the hot path
+    Workers workers_;
+    std::vector<bool> used_slots_; // a worker's slot selects its cpu & metrics
+#if THREAD_POOL_METRICS
+    std::deque<Detail::WorkerMetrics> metrics_; // per slot
+#endif
+    std::deque<Detail::TraceRing> traces_; // per slot - empty if tracing is off
+    const PriorityTaskQueue::Clock::time_point trace_epoch_{PriorityTaskQueue::Clock::now()};
+    std::vector<std::jthread> retired_workers_;
+    bool is_shutting_down_{};
+    std::once_flag timers_created_;
+    std::unique_ptr<TimerService> timers_; // created by the first submit_after/submit_every
+
+    inline static thread_local bool is_blocking_ = false; // a nested blocking region is not counted again
+    inline static thread_local size_t current_slot_ = 0; // valid only if current() == this
+
+    void run(std::stop_token stop_token, Workers::iterator self, size_t slot)
+    {
+        set_current(this);
+        current_slot_ = slot;
+
+        std::optional<Detail::TaskArena::Attachment> arena;
+        if (options_.task_arenas)
+            arena.emplace();
+
+        if (!placement_.empty())
+            pin_current_thread(placement_[slot]);
+
+#if THREAD_POOL_METRICS
+        auto& metrics = worker_metrics(slot);
+        auto last_finished = PriorityTaskQueue::Clock::now();
+#endif
+        Detail::TraceRing* const trace = worker_trace(slot);
+
+        Detail::AdaptiveSpinner spinner{options_.idle_strategy};
+
+        while (!stop_token.stop_requested())
+        {
+            Task task;
+            auto dequeued = spinner.is_enabled() ? spin_for_task(spinner, task) : std::nullopt;
+
+            if (!dequeued)
+            {
+                dequeued = tasks_.pop_for(task, options_.idle_timeout);
+
+                if (!dequeued)
+                {
+                    if (tasks_.is_closed() || try_retire(self, slot, options_.min_threads))
+                        break;
+                    continue;
+                }
+
+                if (spinner.is_enabled())
+                    spinner.unparked();
+            }
+
+            if (dequeued->wait_time > options_.grow_wait_time)
+                grow(1);
+
+#if THREAD_POOL_METRICS
+            const auto started = PriorityTaskQueue::Clock::now();
+            task();
+            const auto finished = PriorityTaskQueue::Clock::now();
+
+            metrics.record(dequeued->depth, dequeued->wait_time, started - last_finished, finished - started);
+            last_finished = finished;
+
+            if (trace)
+                trace->record(trace_epoch_, *dequeued, started, finished);
+#else
+            if (trace)
+            {
+                const auto started = PriorityTaskQueue::Clock::now();
+                task();
+                trace->record(trace_epoch_, *dequeued, started, PriorityTaskQueue::Clock::now());
+            }
+            else
+                task();
+#endif
+
+            // a compensating worker is no longer needed once the blocked tasks have finished
+            if (threads_count_.load(std::memory_order_relaxed) > options_.max_threads + blocked_count_.load(std::memory_order_relaxed)
+                && try_retire(self, slot, options_.max_threads))
+                break;
+        }
+    }
+
+    void spawn_worker() // mtx_workers_ must be locked
+    {
+        const auto slot = static_cast<size_t>(std::ranges::find(used_slots_, false) - used_slots_.begin());
+        if (slot == used_slots_.size())
+        {
+            used_slots_.push_back(false);
+#if THREAD_POOL_METRICS
+            metrics_.emplace_back();
+#endif
+            if (options_.trace_buffer_size != 0)
+                traces_.emplace_back(options_.trace_buffer_size);
+        }
+
+        auto self = workers_.emplace(workers_.end());
+
+        try
+        {
+            *self = std::jthread{[this, self, slot](std::stop_token stop_token) {
+                run(stop_token, self, slot);
+            }};
+        }
+        catch (...)
+        {
+            workers_.erase(self);
+            throw;
+        }
+
+        used_slots_[slot] = true;
+        ++threads_count_;
+    }
+
+    std::optional<PriorityTaskQueue::Dequeued> spin_for_task(Detail::AdaptiveSpinner& spinner, Task& task)
+    {
+        if (auto dequeued = tasks_.try_pop(task))
+            return dequeued;
+
+        tasks_.add_spinning_consumer();
+        auto dequeued = spinner.spin([this] { return tasks_.maybe_has_tasks(); }, [&] { return tasks_.try_pop(task); });
+        tasks_.remove_spinning_consumer();
+
+        return dequeued;
+    }
+
+#if THREAD_POOL_METRICS
+    Detail::WorkerMetrics& worker_metrics(size_t slot)
+    {
+        std::lock_guard lk{mtx_workers_};
+        return metrics_[slot];
+    }
+#endif
+
+    Detail::TraceRing* worker_trace(size_t slot)
+    {
+        std::lock_guard lk{mtx_workers_};
+        return traces_.empty() ? nullptr : &traces_[slot];
+    }
+
+    size_t threads_limit() const
+    {
+        return options_.max_threads + std::min(blocked_count_.load(std::memory_order_relaxed), options_.max_blocking_threads);
+    }
+
+    void grow(size_t count)
+    {
+        if (threads_count_.load(std::memory_order_relaxed) >= threads_limit())
+            return;
+
+        std::lock_guard lk{mtx_workers_};
+
+        try
+        {
+            for (size_t i = 0; i < count && !is_shutting_down_ && threads_count_ < threads_limit(); ++i)
+                spawn_worker();
+        }
+        catch (const std::system_error&)
+        {
+            // best effort - already running workers will process the backlog
+        }
+    }
+
+    // the worker leaves if there are more than target workers besides the blocked ones
+    bool try_retire(Workers::iterator self, size_t slot, size_t target)
+    {
+        if (threads_count_.load(std::memory_order_relaxed) <= target + blocked_count_.load(std::memory_order_relaxed))
+            return false;
+
+        std::lock_guard lk{mtx_workers_};
+
+        if (is_shutting_down_ || threads_count_ <= target + blocked_count_.load(std::memory_order_relaxed))
+            return false;
+
+        --threads_count_;
+
+        // previously retired workers have already left run() - joining them is quick
+        for (auto& thd : retired_workers_)
+            thd.join();
+        retired_workers_.clear();
+
+        retired_workers_.push_back(std::move(*self));
+        workers_.erase(self);
+        used_slots_[slot] = false;
+
+        return true;
+    }
+
+    void enter_blocking()
+    {
+        const size_t blocked = blocked_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        // keeps min_threads workers runnable - more are spawned on demand (backlog, wait time) up to threads_limit()
+        try
+        {
+            if (threads_count_.load(std::memory_order_relaxed) < options_.min_threads + blocked || tasks_.maybe_has_tasks())
+                grow(1);
+        }
+        catch (...)
+        {
+            leave_blocking();
+            throw;
+        }
+    }
+
+    void leave_blocking() noexcept
+    {
+        blocked_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void grow_if_backlogged(size_t backlog)
+    {
+        if (backlog >= options_.grow_queue_depth)
+            grow((backlog + options_.grow_queue_depth - 1) / options_.grow_queue_depth);
+    }
+
+    TimerService& timers()
+    {
+        std::call_once(timers_created_, [this] { timers_ = std::make_unique<TimerService>(*this); });
+
+        if (!timers_)
+            throw std::runtime_error{"Timer service is stopped"};
+
+        return *timers_;
+    }
+
+    // After shutdown only tasks running on this pool may push - follow-up work is drained too.
+    // Returns false if the task is rejected (after shutdown or by OverflowPolicy::reject) - the task is left untouched.
+    bool try_push(Task& task, TaskPriority priority)
+    {
+        const bool from_worker = current() == this;
+
+        const auto backlog = options_.overflow_policy == OverflowPolicy::block && !from_worker
+            ? tasks_.push_if_open(task, priority)
+            : tasks_.try_push(task, priority, from_worker);
+
+        if (backlog)
+        {
+            grow_if_backlogged(*backlog);
+            return true;
+        }
+
+        if (options_.overflow_policy == OverflowPolicy::reject || (!from_worker && tasks_.is_closed()))
+            return false;
+
+        Task{std::move(task)}();
+        return true;
+    }
+
+    void push(Task&& task, TaskPriority priority)
+    {
+        if (try_push(task, priority))
+            return;
+
+        if (tasks_.is_closed())
+            throw std::runtime_error{"Push to a closed queue"};
+
+        throw QueueFullError{};
+    }
+
+    void push_bulk(std::vector<Task>& tasks, TaskPriority priority)
+    {
+        const bool from_worker = current() == this;
+
+        if (options_.overflow_policy == OverflowPolicy::block && !from_worker)
+        {
+            grow_if_backlogged(tasks_.push_bulk(tasks, priority));
+            return;
+        }
+
+        if (auto backlog = tasks_.try_push_bulk(tasks, priority, from_worker))
+        {
+            grow_if_backlogged(*backlog);
+            return;
+        }
+
+        if (options_.overflow_policy == OverflowPolicy::reject)
+            throw QueueFullError{};
+
+        for (auto& task : tasks) // as many as fit are queued
+            push(std::move(task), priority);
+    }
+
+    // pushes the task of a make_task() pair - returns its future
+    template <typename TaskAndFuture>
+    auto push_task(TaskAndFuture task_and_future, TaskPriority priority)
+    {
+        auto& [task, f_result] = task_and_future;
+        push(std::move(task), priority);
+
+        return std::move(f_result);
+    }
+
+protected:
+    uint64_t wake_epoch() const noexcept override
+    {
+        return tasks_.wake_epoch();
+    }
+
+    // helped tasks are accounted to the waiting task in stats()
+    void run_pending_task(uint64_t epoch) override
+    {
+        Task task;
+        if (tasks_.pop_until_woken(task, epoch))
+            task();
+    }
+
+public:
+    // Marks a scope of a pool's task that blocks (sleep, I/O, lock, get() of an outside future) - another worker is spawned
+    // meanwhile, so the other tasks keep running. Surplus workers retire after their current task once the region ends.
+    // Has no effect outside of the pool's workers & inside another blocking region.
+    class [[nodiscard]] BlockingRegion
+    {
+        ThreadPool* pool_;
+
+    public:
+        explicit BlockingRegion(ThreadPool& pool)
+            : pool_{pool.current() == &pool && !is_blocking_ ? &pool : nullptr}
+        {
+            if (pool_)
+            {
+                pool_->enter_blocking();
+                is_blocking_ = true;
+            }
+        }
+
+        BlockingRegion(const BlockingRegion&) = delete;
+        BlockingRegion& operator=(const BlockingRegion&) = delete;
+
+        ~BlockingRegion()
+        {
+            if (pool_)
+            {
+                pool_->leave_blocking();
+                is_blocking_ = false;
+            }
+        }
+    };
+
+    ThreadPool(size_t size = std::thread::hardware_concurrency())
+        : ThreadPool{ThreadPoolOptions{.min_threads = size, .max_threads = size}}
+    {
+    }
+
+    explicit ThreadPool(const ThreadPoolOptions& options)
+        : options_{options}
+        , placement_{options.placement, options.placement == WorkerPlacement::none ? std::vector<NumaNode>{} : numa_nodes()}
+        , tasks_{PriorityTaskQueue::default_starvation_limit, options.queue_capacity}
+    {
+        if (options_.min_threads == 0 || options_.min_threads > options_.max_threads)
+            throw std::invalid_argument{"ThreadPool requires 0 < min_threads <= max_threads"};
+
+        std::lock_guard lk{mtx_workers_};
+        for (size_t i = 0; i < options_.min_threads; ++i)
+            spawn_worker();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        shutdown(ShutdownMode::drain);
+    }
+
+    // Closes the queue (further submits from outside of the pool throw) & joins all workers.
+    // Must not be called from a pool's task.
+    // Only the first call has an effect.
+    void shutdown(ShutdownMode mode = ShutdownMode::drain)
+    {
+        Workers workers;
+        std::vector<std::jthread> retired_workers;
+
+        {
+            std::lock_guard lk{mtx_workers_};
+
+            if (is_shutting_down_)
+                return;
+
+            is_shutting_down_ = true;
+            workers = std::move(workers_);
+            retired_workers = std::move(retired_workers_);
+        }
+
+        // pending timers are dropped - their futures get broken_promise
+        std::call_once(timers_created_, [] { });
+        if (timers_)
+            timers_->stop();
+
+        if (mode == ShutdownMode::cancel_pending)
+        {
+            for (auto& thd : workers)
+                thd.request_stop();
+        }
+
+        tasks_.close();
+
+        if (mode == ShutdownMode::cancel_pending)
+            tasks_.clear();
+
+        for (auto& thd : workers)
+            thd.join();
+
+        for (auto& thd : retired_workers)
+            thd.join();
+
+        tasks_.clear(); // follow-up tasks submitted by cancelled workers
+    }
+
+    // current number of workers
+    size_t size() const
+    {
+        return threads_count_;
+    }
+
+    // Slot of the calling worker - std::nullopt outside of the pool's workers.
+    // Slots of running workers are distinct & below max_slots(), a retired worker's slot is reused by a new one.
+    std::optional<size_t> worker_slot() const noexcept
+    {
+        if (current() != this)
+            return std::nullopt;
+        return current_slot_;
+    }
+
+    size_t max_slots() const noexcept
+    {
+        return options_.max_threads + options_.max_blocking_threads;
+    }
+
+    void post(Task&& task) override
+    {
+        push(std::move(task), TaskPriority::normal);
+    }
+
+    Task try_post(Task&& task) override
+    {
+        if (try_push(task, TaskPriority::normal))
+            return {};
+
+        return std::move(task);
+    }
+
+    // sender/receiver access - schedule() completes on a worker, bulk() spreads over the workers
+    Exec::Scheduler<ThreadPool> get_scheduler()
+    {
+        return Exec::Scheduler<ThreadPool>{*this};
+    }
+
+    void wake_helpers() override
+    {
+        tasks_.wake_consumers();
+    }
+
+    template <typename Function>
+    auto submit(Function&& f, TaskPriority priority = TaskPriority::normal)
+    {
+        return push_task(make_task(std::forward<Function>(f), this), priority);
+    }
+
+    // f returns Expected<T, E> - a failure travels to get() as a value: no throw, exception_ptr or rethrow on the way.
+    // Only exceptions escaping f (or a dropped task) still reach get() as exceptions.
+    template <typename Function>
+        requires is_expected_v<std::invoke_result_t<std::decay_t<Function>&>>
+    auto try_submit(Function&& f, TaskPriority priority = TaskPriority::normal)
+    {
+        return push_task(make_task(std::forward<Function>(f), this), priority);
+    }
+
+    // f(std::stop_token) - the returned CancellableFuture can cancel() the task: a queued task is skipped,
+    // a running one is asked to stop through the token
+    template <typename Function>
+        requires std::invocable<std::decay_t<Function>&, std::stop_token>
+    auto submit(Function&& f, TaskPriority priority = TaskPriority::normal)
+    {
+        return push_task(make_cancellable_task(std::forward<Function>(f), this), priority);
+    }
+
+    // f runs inside a blocking region - for tasks that mostly wait
+    template <typename Function>
+    auto submit_blocking(Function&& f, TaskPriority priority = TaskPriority::normal)
+    {
+        return submit([this, f = std::forward<Function>(f)]() mutable {
+            BlockingRegion region{*this};
+            return std::invoke(f);
+        }, priority);
+    }
+
+    // auto region = pool.blocking_region(); inside a task before it blocks
+    BlockingRegion blocking_region()
+    {
+        return BlockingRegion{*this};
+    }
+
+    // f runs on a worker after delay - no worker is blocked in the meantime
+    template <typename Function>
+    auto submit_after(std::chrono::steady_clock::duration delay, Function&& f)
+    {
+        auto [task, f_result] = make_task(std::forward<Function>(f), this);
+        timers().post_after(delay, std::move(task));
+
+        return std::move(f_result);
+    }
+
+    // f runs on a worker every period until the returned handle is cancelled
+    template <typename Function>
+    TimerHandle submit_every(std::chrono::steady_clock::duration period, Function&& f)
+    {
+        return timers().post_every(period, Task{std::forward<Function>(f)});
+    }
+
+    // co_await pool.schedule() resumes the coroutine on a worker
+    Coro::ScheduleAwaiter schedule() noexcept
+    {
+        return Coro::schedule(*this);
+    }
+
+    // Submits f(item) for every item in range - the whole batch is enqueued under one lock (unless it overflows the queue).
+    // f is copied into every task, items are passed by value.
+    template <std::ranges::input_range Range, typename Function>
+    auto submit_bulk(Range&& range, Function f, TaskPriority priority = TaskPriority::normal)
+    {
+        using Item = std::ranges::range_value_t<Range>;
+        using T = std::invoke_result_t<Function&, Item&>;
+
+        std::vector<Task> tasks;
+        std::vector<Future<T>> f_results;
+
+        if constexpr (std::ranges::sized_range<Range>)
+        {
+            tasks.reserve(std::ranges::size(range));
+            f_results.reserve(std::ranges::size(range));
+        }
+
+        for (auto&& item : range)
+        {
+            auto [task, f_result] = make_task([f, item = Item(item)]() mutable { return std::invoke(f, item); }, this);
+            tasks.push_back(std::move(task));
+            f_results.push_back(std::move(f_result));
+        }
+
+        push_bulk(tasks, priority);
+
+        return f_results;
+    }
+
+    // queue depth & enqueue-to-start wait times per priority lane
+    std::array<PriorityTaskQueue::LaneStats, task_priority_levels> lane_stats() const
+    {
+        return tasks_.lane_stats();
+    }
+
+#if THREAD_POOL_METRICS
+    // merges per-worker metrics - stats.to_text() or stats.to_json() dump the snapshot
+    ThreadPoolStats stats() const
+    {
+        ThreadPoolStats stats;
+
+        std::lock_guard lk{mtx_workers_};
+        for (size_t slot = 0; slot < metrics_.size(); ++slot)
+            metrics_[slot].merge_into(stats, slot);
+
+        return stats;
+    }
+#endif
+
+    // Writes the last trace_buffer_size task spans of every worker as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+    // Can be called while the pool is running. Tasks run while waiting for a future or inline by a submitter are not traced.
+    void dump_trace(std::ostream& out) const
+    {
+        std::vector<std::vector<Detail::TraceSpan>> spans_per_slot;
+
+        {
+            std::lock_guard lk{mtx_workers_};
+            for (const auto& trace : traces_)
+                spans_per_slot.push_back(trace.snapshot());
+        }
+
+        Detail::write_chrome_trace(out, spans_per_slot);
+    }
+};
+
+namespace WorkStealing
+{
+
+    // Every worker owns a deque - tasks submitted from a worker go to its own deque (LIFO),
+    // tasks submitted from outside are spread round-robin, idle workers steal (FIFO).
+    // A push touches shared state only to wake a parked worker (EventCount).
+    class ThreadPool : public Executor
+    {
+        std::vector<std::unique_ptr<WorkStealingQueue<Task>>> queues_;
+        std::atomic<size_t> next_queue_{};
+        EventCount events_; // a push or wake_helpers() advances the epoch
+        std::vector<std::jthread> threads_;
+
+        inline static thread_local size_t current_index_ = 0;
+
+        bool try_pop_task(size_t index, Task& task)
+        {
+            if (queues_[index]->try_pop(task))
+                return true;
+
+            for (size_t i = 1; i < queues_.size(); ++i)
+            {
+                if (queues_[(index + i) % queues_.size()]->try_steal(task))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // a steal may miss a task of a contended deque - a worker checks all deques under their locks before it parks
+        bool has_tasks() const
+        {
+            return std::ranges::any_of(queues_, [](const auto& queue) { return !queue->empty(); });
+        }
+
+        void run(size_t index, std::stop_token stop_token)
+        {
+            set_current(this);
+            current_index_ = index;
+
+            while (true)
+            {
+                Task task;
+                if (try_pop_task(index, task))
+                {
+                    task();
+                    continue;
+                }
+
+                const auto epoch = events_.prepare_wait();
+
+                if (has_tasks())
+                {
+                    events_.cancel_wait();
+                    continue;
+                }
+
+                if (stop_token.stop_requested()) // all queues drained
+                {
+                    events_.cancel_wait();
+                    break;
+                }
+
+                events_.commit_wait(epoch);
+            }
+        }
+
+        void push(Task&& task)
+        {
+            if (current() == this)
+                queues_[current_index_]->push(std::move(task));
+            else
+                queues_[next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size()]->push(std::move(task));
+
+            events_.notify_one();
+        }
+
+    protected:
+        uint64_t wake_epoch() const noexcept override
+        {
+            return events_.epoch();
+        }
+
+        void run_pending_task(uint64_t epoch) override
+        {
+            Task task;
+            if (try_pop_task(current_index_, task))
+            {
+                task();
+                return;
+            }
+
+            const auto current_epoch = events_.prepare_wait();
+
+            if (current_epoch != epoch || has_tasks())
+            {
+                events_.cancel_wait();
+                return;
+            }
+
+            events_.commit_wait(current_epoch);
+        }
+
+    public:
+        ThreadPool(size_t size = std::thread::hardware_concurrency())
+        {
+            if (size == 0)
+                throw std::invalid_argument{"Thread pool must have at least one worker"};
+
+            for (size_t i = 0; i < size; ++i)
+                queues_.push_back(std::make_unique<WorkStealingQueue<Task>>());
+
+            threads_.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+                threads_.emplace_back([this, i](std::stop_token stop_token) {
+                    run(i, stop_token);
+                });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            for (auto& thd : threads_)
+                thd.request_stop();
+
+            events_.notify_all();
+
+            for (auto& thd : threads_)
+                thd.join();
+        }
+
+        size_t size() const
+        {
+            return threads_.size();
+        }
+
+        void post(Task&& task) override
+        {
+            push(std::move(task));
+        }
+
+        // never rejects
+        Task try_post(Task&& task) override
+        {
+            push(std::move(task));
+            return {};
+        }
+
+        Exec::Scheduler<ThreadPool> get_scheduler()
+        {
+            return Exec::Scheduler<ThreadPool>{*this};
+        }
+
+        void wake_helpers() override
+        {
+            events_.notify_all();
+        }
+
+        template <typename Function>
+        auto submit(Function&& f)
+        {
+            auto [task, f_result] = make_task(std::forward<Function>(f), this);
+            push(std::move(task));
+
+            return std::move(f_result);
+        }
+    };
+
+} // namespace WorkStealing
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,145 @@
+#ifndef THREAD_POOL_METRICS_HPP
+#define THREAD_POOL_METRICS_HPP
+
+#include "histogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ThreadPool metrics are recorded unless compiled with THREAD_POOL_METRICS=0 - then the workers record nothing
+#ifndef THREAD_POOL_METRICS
+#define THREAD_POOL_METRICS 1
+#endif
+
+struct WorkerStats
+{
+    size_t slot; // workers started after retired ones reuse their slots
+    uint64_t tasks_completed;
+    std::chrono::nanoseconds busy_time;
+    std::chrono::nanoseconds idle_time; // waiting for tasks - counted when the next task starts
+
+    double busy_ratio() const
+    {
+        const auto total = busy_time + idle_time;
+        return total.count() ? static_cast<double>(busy_time.count()) / total.count() : 0.0;
+    }
+};
+
+// Snapshot of ThreadPool metrics - histograms are merged from all workers
+struct ThreadPoolStats
+{
+    std::vector<WorkerStats> workers;
+    Log2Histogram queue_depth; // tasks in the queue when a task was taken (including the taken one)
+    Log2Histogram wait_time; // enqueue-to-start in ns
+    Log2Histogram execution_time; // in ns
+
+    uint64_t tasks_completed() const
+    {
+        return std::accumulate(workers.begin(), workers.end(), uint64_t{}, [](uint64_t sum, const WorkerStats& w) { return sum + w.tasks_completed; });
+    }
+
+    std::string to_text() const
+    {
+        std::ostringstream out;
+
+        out << "tasks completed: " << tasks_completed() << "\n";
+        print_text(out, "queue depth", queue_depth);
+        print_text(out, "wait time [ns]", wait_time);
+        print_text(out, "execution time [ns]", execution_time);
+
+        for (const auto& w : workers)
+        {
+            out << "worker #" << w.slot << ": tasks = " << w.tasks_completed
+                << ", busy = " << std::chrono::duration_cast<std::chrono::milliseconds>(w.busy_time).count() << "ms"
+                << ", idle = " << std::chrono::duration_cast<std::chrono::milliseconds>(w.idle_time).count() << "ms"
+                << ", busy ratio = " << w.busy_ratio() << "\n";
+        }
+
+        return out.str();
+    }
+
+    std::string to_json() const
+    {
+        std::ostringstream out;
+
+        out << "{\"tasks_completed\": " << tasks_completed();
+        print_json(out, "queue_depth", queue_depth);
+        print_json(out, "wait_time_ns", wait_time);
+        print_json(out, "execution_time_ns", execution_time);
+
+        out << ", \"workers\": [";
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            const auto& w = workers[i];
+            out << (i ? ", " : "")
+                << "{\"slot\": " << w.slot
+                << ", \"tasks_completed\": " << w.tasks_completed
+                << ", \"busy_time_ns\": " << w.busy_time.count()
+                << ", \"idle_time_ns\": " << w.idle_time.count()
+                << ", \"busy_ratio\": " << w.busy_ratio() << "}";
+        }
+        out << "]}";
+
+        return out.str();
+    }
+
+private:
+    static void print_text(std::ostream& out, const char* name, const Log2Histogram& h)
+    {
+        out << name << ": count = " << h.count() << ", mean = " << h.mean() << ", p50 = " << h.percentile(0.5)
+            << ", p99 = " << h.percentile(0.99) << ", max = " << h.max() << "\n";
+    }
+
+    static void print_json(std::ostream& out, const char* name, const Log2Histogram& h)
+    {
+        out << ", \"" << name << "\": {\"count\": " << h.count() << ", \"mean\": " << h.mean() << ", \"p50\": " << h.percentile(0.5)
+            << ", \"p99\": " << h.percentile(0.99) << ", \"max\": " << h.max() << "}";
+    }
+};
+
+namespace Detail
+{
+    // Written by one worker, read by stats() at any time - relaxed single-writer counters, no lock on the hot path.
+    // A snapshot taken while a task is recorded may count it only partially.
+    class alignas(64) WorkerMetrics
+    {
+        std::atomic<uint64_t> tasks_completed_{};
+        std::atomic<uint64_t> busy_time_{}; // in ns
+        std::atomic<uint64_t> idle_time_{}; // in ns
+        ConcurrentLog2Histogram queue_depth_;
+        ConcurrentLog2Histogram wait_time_;
+        ConcurrentLog2Histogram execution_time_;
+
+    public:
+        template <typename Duration>
+        void record(size_t queue_depth, Duration wait_time, Duration idle_time, Duration execution_time) noexcept
+        {
+            using std::chrono::nanoseconds;
+
+            Detail::add_relaxed(tasks_completed_, 1);
+            Detail::add_relaxed(busy_time_, nanoseconds(execution_time).count());
+            Detail::add_relaxed(idle_time_, nanoseconds(idle_time).count());
+            queue_depth_.record(queue_depth);
+            wait_time_.record(nanoseconds(wait_time).count());
+            execution_time_.record(nanoseconds(execution_time).count());
+        }
+
+        void merge_into(ThreadPoolStats& stats, size_t slot) const
+        {
+            using std::chrono::nanoseconds;
+
+            stats.workers.push_back(WorkerStats{slot, tasks_completed_.load(std::memory_order_relaxed),
+                nanoseconds(busy_time_.load(std::memory_order_relaxed)), nanoseconds(idle_time_.load(std::memory_order_relaxed))});
+            queue_depth_.merge_into(stats.queue_depth);
+            wait_time_.merge_into(stats.wait_time);
+            execution_time_.merge_into(stats.execution_time);
+        }
+    };
+}
+
+#endif // THREAD_POOL_METRICS_HPP
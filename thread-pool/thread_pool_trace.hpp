@@ -0,0 +1,162 @@
+#ifndef THREAD_POOL_TRACE_HPP
+#define THREAD_POOL_TRACE_HPP
+
+#include "priority_task_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace Detail
+{
+    // Enqueue, start & end of one task - the enqueue time is derived from the time the task waited in the queue
+    struct TraceSpan
+    {
+        int64_t enqueued_ns; // since the trace epoch
+        int64_t started_ns;
+        int64_t finished_ns;
+        uint64_t depth_and_priority; // queue depth << 2 | priority
+
+        size_t depth() const
+        {
+            return depth_and_priority >> 2;
+        }
+
+        TaskPriority priority() const
+        {
+            return static_cast<TaskPriority>(depth_and_priority & 3);
+        }
+    };
+
+    // Ring buffer of the last spans of one worker - written only by the worker (a few plain stores per task on x86),
+    // read concurrently by dump_trace(). Fields are atomics, so a span overwritten during a read is dropped, not torn.
+    class alignas(64) TraceRing
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct Slot
+        {
+            std::atomic<int64_t> enqueued_ns;
+            std::atomic<int64_t> started_ns;
+            std::atomic<int64_t> finished_ns;
+            std::atomic<uint64_t> depth_and_priority;
+        };
+
+        std::unique_ptr<Slot[]> slots_;
+        const size_t mask_;
+        std::atomic<uint64_t> started_{}; // spans being written or written - a seqlock for readers
+        std::atomic<uint64_t> written_{}; // spans completely written
+
+    public:
+        // capacity is rounded up to a power of two
+        explicit TraceRing(size_t capacity)
+            : slots_{std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 1)))}
+            , mask_{std::bit_ceil(std::max<size_t>(capacity, 1)) - 1}
+        {
+        }
+
+        void record(Clock::time_point epoch, const PriorityTaskQueue::Dequeued& dequeued, Clock::time_point started, Clock::time_point finished) noexcept
+        {
+            using std::chrono::nanoseconds;
+
+            const uint64_t index = written_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[index & mask_];
+
+            started_.store(index + 1, std::memory_order_relaxed); // release stores below keep it ahead of the data
+
+            slot.enqueued_ns.store(nanoseconds(started - dequeued.wait_time - epoch).count(), std::memory_order_release);
+            slot.started_ns.store(nanoseconds(started - epoch).count(), std::memory_order_release);
+            slot.finished_ns.store(nanoseconds(finished - epoch).count(), std::memory_order_release);
+            slot.depth_and_priority.store(dequeued.depth << 2 | static_cast<uint64_t>(dequeued.priority), std::memory_order_release);
+
+            written_.store(index + 1, std::memory_order_release);
+        }
+
+        // oldest first
+        std::vector<TraceSpan> snapshot() const
+        {
+            const uint64_t capacity = mask_ + 1;
+            const uint64_t written = written_.load(std::memory_order_acquire);
+
+            std::vector<TraceSpan> spans;
+            for (uint64_t i = written > capacity ? written - capacity : 0; i < written; ++i)
+            {
+                const Slot& slot = slots_[i & mask_];
+                spans.push_back(TraceSpan{
+                    slot.enqueued_ns.load(std::memory_order_acquire),
+                    slot.started_ns.load(std::memory_order_acquire),
+                    slot.finished_ns.load(std::memory_order_acquire),
+                    slot.depth_and_priority.load(std::memory_order_acquire)});
+            }
+
+            // the worker may have overwritten the oldest spans meanwhile - a span whose new data was read is counted in started_
+            const uint64_t started = started_.load(std::memory_order_relaxed);
+            const uint64_t first_valid = started > capacity ? started - capacity : 0;
+            const uint64_t first_read = written > capacity ? written - capacity : 0;
+
+            if (first_valid > first_read)
+                spans.erase(spans.begin(), spans.begin() + std::min<uint64_t>(first_valid - first_read, spans.size()));
+
+            return spans;
+        }
+    };
+
+    inline const char* to_string(TaskPriority priority)
+    {
+        switch (priority)
+        {
+        case TaskPriority::high:
+            return "high";
+        case TaskPriority::normal:
+            return "normal";
+        case TaskPriority::low:
+            return "low";
+        }
+
+        return "unknown";
+    }
+
+    // Chrome trace event format (chrome://tracing, ui.perfetto.dev):
+    // - every worker slot is a thread with a "task" slice per run task
+    // - time spent in the queue is an async "queued" slice (they overlap, so they get their own tracks)
+    inline void write_chrome_trace(std::ostream& out, const std::vector<std::vector<TraceSpan>>& spans_per_slot)
+    {
+        const auto us = [](int64_t ns) { return ns / 1000.0; };
+
+        out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        out << R"({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "ThreadPool"}})";
+
+        uint64_t id = 0;
+        for (size_t slot = 0; slot < spans_per_slot.size(); ++slot)
+        {
+            out << ",\n" << R"({"name": "thread_name", "ph": "M", "pid": 1, "tid": )" << slot
+                << R"(, "args": {"name": "worker #)" << slot << "\"}}";
+
+            for (const auto& span : spans_per_slot[slot])
+            {
+                const char* priority = to_string(span.priority());
+
+                out << ",\n" << R"({"name": "queued", "cat": "queue", "ph": "b", "pid": 1, "tid": )" << slot
+                    << ", \"id\": " << id << ", \"ts\": " << us(span.enqueued_ns)
+                    << R"(, "args": {"priority": ")" << priority << "\"}}";
+                out << ",\n" << R"({"name": "queued", "cat": "queue", "ph": "e", "pid": 1, "tid": )" << slot
+                    << ", \"id\": " << id << ", \"ts\": " << us(span.started_ns) << "}";
+                out << ",\n" << R"({"name": "task", "cat": "task", "ph": "X", "pid": 1, "tid": )" << slot
+                    << ", \"ts\": " << us(span.started_ns) << ", \"dur\": " << us(span.finished_ns - span.started_ns)
+                    << R"(, "args": {"priority": ")" << priority << R"(", "queue_depth": )" << span.depth()
+                    << ", \"wait_us\": " << us(span.started_ns - span.enqueued_ns) << "}}";
+
+                ++id;
+            }
+        }
+
+        out << "\n]}\n";
+    }
+} // namespace Detail
+
+#endif // THREAD_POOL_TRACE_HPP
@@ -0,0 +1,536 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "executor.hpp"
+#include "task.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Detail
+{
+    // Hierarchical timing wheel - levels of 64 slots, every level is 64 times coarser than the one below.
+    // Timers are intrusive doubly-linked list nodes kept in a slab, so link & unlink are O(1).
+    // Not synchronized.
+    class TimerWheel
+    {
+    public:
+        static constexpr uint32_t no_timer = std::numeric_limits<uint32_t>::max();
+
+        enum class TimerState : uint8_t
+        {
+            free,
+            armed, // linked into a slot
+            running // periodic task handed over to the executor
+        };
+
+        struct Timer
+        {
+            Task task;
+            uint64_t deadline{};
+            uint64_t period{}; // in ticks - 0 for one-shot timers
+            uint32_t index{};
+            uint32_t generation{};
+            uint32_t prev{no_timer};
+            uint32_t next{no_timer};
+            uint8_t level{};
+            uint8_t slot{};
+            TimerState state{TimerState::free};
+            bool is_cancelled{};
+        };
+
+    private:
+        static constexpr unsigned slot_bits = 6;
+        static constexpr size_t slots_count = size_t{1} << slot_bits;
+        static constexpr size_t levels_count = 4; // 2^24 ticks - later deadlines wait at the top level
+
+        std::array<std::array<uint32_t, slots_count>, levels_count> slots_;
+        std::deque<Timer> timers_; // stable addresses
+        std::vector<uint32_t> free_timers_;
+        uint64_t current_tick_{};
+        size_t armed_count_{};
+
+        static size_t slot_of(uint64_t tick, size_t level)
+        {
+            return (tick >> (slot_bits * level)) & (slots_count - 1);
+        }
+
+        // moves timers of a coarse slot to finer levels
+        void cascade(size_t level)
+        {
+            uint32_t index = std::exchange(slots_[level][slot_of(current_tick_, level)], no_timer);
+
+            while (index != no_timer)
+            {
+                Timer& timer = timers_[index];
+                index = timer.next;
+                --armed_count_;
+                link(timer, timer.deadline);
+            }
+        }
+
+    public:
+        TimerWheel()
+        {
+            for (auto& level : slots_)
+                level.fill(no_timer);
+        }
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        uint64_t current_tick() const
+        {
+            return current_tick_;
+        }
+
+        bool empty() const
+        {
+            return armed_count_ == 0;
+        }
+
+        size_t size() const
+        {
+            return armed_count_;
+        }
+
+        Timer& operator[](uint32_t index)
+        {
+            return timers_[index];
+        }
+
+        Timer* find(uint32_t index, uint32_t generation)
+        {
+            if (index >= timers_.size() || timers_[index].generation != generation || timers_[index].state == TimerState::free)
+                return nullptr;
+
+            return &timers_[index];
+        }
+
+        Timer& allocate(Task task, uint64_t period)
+        {
+            Timer* timer;
+
+            if (free_timers_.empty())
+            {
+                timer = &timers_.emplace_back();
+                timer->index = static_cast<uint32_t>(timers_.size() - 1);
+            }
+            else
+            {
+                timer = &timers_[free_timers_.back()];
+                free_timers_.pop_back();
+            }
+
+            timer->task = std::move(task);
+            timer->period = period;
+            timer->is_cancelled = false;
+            timer->state = TimerState::running;
+
+            return *timer;
+        }
+
+        // invalidates handles to the timer
+        void release(Timer& timer)
+        {
+            timer.task = Task{};
+            timer.state = TimerState::free;
+            ++timer.generation;
+            free_timers_.push_back(timer.index);
+        }
+
+        // deadline must not be earlier than the current tick
+        void link(Timer& timer, uint64_t deadline)
+        {
+            timer.deadline = deadline;
+
+            const uint64_t delta = std::min(deadline - current_tick_, (uint64_t{1} << (slot_bits * levels_count)) - 1);
+
+            size_t level = 0;
+            while (delta >= (uint64_t{1} << (slot_bits * (level + 1))))
+                ++level;
+
+            const size_t slot = slot_of(current_tick_ + delta, level);
+            uint32_t& head = slots_[level][slot];
+
+            timer.level = static_cast<uint8_t>(level);
+            timer.slot = static_cast<uint8_t>(slot);
+            timer.prev = no_timer;
+            timer.next = head;
+            if (head != no_timer)
+                timers_[head].prev = timer.index;
+            head = timer.index;
+
+            timer.state = TimerState::armed;
+            ++armed_count_;
+        }
+
+        void unlink(Timer& timer)
+        {
+            if (timer.prev != no_timer)
+                timers_[timer.prev].next = timer.next;
+            else
+                slots_[timer.level][timer.slot] = timer.next;
+
+            if (timer.next != no_timer)
+                timers_[timer.next].prev = timer.prev;
+
+            timer.state = TimerState::running;
+            --armed_count_;
+        }
+
+        // Advances to tick - on_expired(timer) is called for every unlinked due timer.
+        // An empty wheel jumps straight to tick.
+        template <typename Callback>
+        void advance(uint64_t tick, Callback on_expired)
+        {
+            while (current_tick_ < tick && !empty())
+            {
+                ++current_tick_;
+
+                size_t top_level = 0;
+                while (top_level + 1 < levels_count && slot_of(current_tick_, top_level) == 0)
+                    ++top_level;
+
+                // coarser levels first - their timers may land in slots cascaded right after
+                for (size_t level = top_level; level > 0; --level)
+                    cascade(level);
+
+                uint32_t index = std::exchange(slots_[0][slot_of(current_tick_, 0)], no_timer);
+                while (index != no_timer)
+                {
+                    Timer& timer = timers_[index];
+                    index = timer.next;
+                    timer.state = TimerState::running;
+                    --armed_count_;
+                    on_expired(timer);
+                }
+            }
+
+            current_tick_ = std::max(current_tick_, tick);
+        }
+
+        // unlinks all timers
+        template <typename Callback>
+        void clear(Callback on_removed)
+        {
+            for (auto& level : slots_)
+            {
+                for (auto& head : level)
+                {
+                    uint32_t index = std::exchange(head, no_timer);
+                    while (index != no_timer)
+                    {
+                        Timer& timer = timers_[index];
+                        index = timer.next;
+                        timer.state = TimerState::running;
+                        --armed_count_;
+                        on_removed(timer);
+                    }
+                }
+            }
+        }
+
+        // ticks to sleep before calling advance() - at most until the next cascade
+        uint64_t ticks_to_next_event() const
+        {
+            const size_t current_slot = slot_of(current_tick_, 0);
+
+            for (size_t i = 1; i < slots_count - current_slot; ++i)
+                if (slots_[0][current_slot + i] != no_timer)
+                    return i;
+
+            return slots_count - current_slot;
+        }
+    };
+}
+
+class TimerService;
+
+// Cancels a pending timer - must not be used after the service is destroyed
+class TimerHandle
+{
+    TimerService* service_{};
+    uint32_t index_{Detail::TimerWheel::no_timer};
+    uint32_t generation_{};
+
+public:
+    TimerHandle() = default;
+
+    TimerHandle(TimerService* service, uint32_t index, uint32_t generation)
+        : service_{service}
+        , index_{index}
+        , generation_{generation}
+    {
+    }
+
+    // returns false if the timer has already fired (one-shot) or was cancelled
+    bool cancel();
+
+    explicit operator bool() const
+    {
+        return service_ != nullptr;
+    }
+};
+
+// Timer thread handing due tasks over to an executor - periodic tasks never overlap,
+// a periodic task that throws is not run again
+class TimerService
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    using Timer = Detail::TimerWheel::Timer;
+    using TimerState = Detail::TimerWheel::TimerState;
+
+    // posted to the executor for every period
+    class PeriodicRunner
+    {
+        TimerService* service_;
+        Timer* timer_;
+
+    public:
+        PeriodicRunner(TimerService* service, Timer* timer) noexcept
+            : service_{service}
+            , timer_{timer}
+        {
+        }
+
+        PeriodicRunner(PeriodicRunner&& other) noexcept
+            : service_{other.service_}
+            , timer_{std::exchange(other.timer_, nullptr)}
+        {
+        }
+
+        PeriodicRunner& operator=(PeriodicRunner&&) = delete;
+
+        ~PeriodicRunner()
+        {
+            if (timer_)
+                service_->finish_periodic(*timer_, false);
+        }
+
+        void operator()()
+        {
+            Timer& timer = *std::exchange(timer_, nullptr);
+            bool has_succeeded = true;
+
+            try
+            {
+                timer.task();
+            }
+            catch (...)
+            {
+                has_succeeded = false;
+            }
+
+            service_->finish_periodic(timer, has_succeeded);
+        }
+    };
+
+    Executor& executor_;
+    const Clock::duration tick_;
+    const Clock::time_point start_;
+    std::mutex mtx_;
+    std::condition_variable_any cv_;
+    Detail::TimerWheel wheel_;
+    uint64_t wakeup_tick_{}; // when the timer thread wakes up next - lowered to wake it up earlier
+    bool is_stopped_{};
+    std::jthread thread_;
+
+    uint64_t tick_of(Clock::time_point time, bool round_up) const
+    {
+        const auto elapsed = time - start_;
+        return static_cast<uint64_t>(elapsed / tick_) + (round_up && elapsed % tick_ != Clock::duration::zero());
+    }
+
+    TimerHandle arm(Clock::duration delay, Clock::duration period, Task task)
+    {
+        const uint64_t deadline = tick_of(Clock::now() + delay, true);
+        const uint64_t period_ticks = std::max<uint64_t>(1, (period + tick_ - Clock::duration{1}) / tick_);
+
+        std::lock_guard lk{mtx_};
+
+        if (is_stopped_)
+            throw std::runtime_error{"Timer service is stopped"};
+
+        if (wheel_.empty())
+            wheel_.advance(tick_of(Clock::now(), false), [](Timer&) { }); // the timer thread sleeps - catch up
+
+        Timer& timer = wheel_.allocate(std::move(task), period == Clock::duration::zero() ? 0 : period_ticks);
+        wheel_.link(timer, std::max(deadline, wheel_.current_tick() + 1));
+        wake_up_before(timer.deadline);
+
+        return TimerHandle{this, timer.index, timer.generation};
+    }
+
+    void wake_up_before(uint64_t tick)
+    {
+        if (tick < wakeup_tick_)
+        {
+            wakeup_tick_ = tick;
+            cv_.notify_one();
+        }
+    }
+
+    void finish_periodic(Timer& timer, bool rearm)
+    {
+        std::lock_guard lk{mtx_};
+
+        if (!rearm || timer.is_cancelled || is_stopped_)
+        {
+            wheel_.release(timer);
+            return;
+        }
+
+        // fixed rate - periods missed while the task was running (or queued) are skipped
+        uint64_t deadline = timer.deadline + timer.period;
+        if (deadline <= wheel_.current_tick())
+            deadline += (wheel_.current_tick() - deadline) / timer.period * timer.period + timer.period;
+
+        wheel_.link(timer, deadline);
+        wake_up_before(deadline);
+    }
+
+    void run(std::stop_token stop_token)
+    {
+        std::vector<Task> due;
+
+        std::unique_lock lk{mtx_};
+
+        while (!stop_token.stop_requested())
+        {
+            wheel_.advance(tick_of(Clock::now(), false), [&](Timer& timer) {
+                if (timer.period == 0)
+                {
+                    due.push_back(std::move(timer.task));
+                    wheel_.release(timer);
+                }
+                else
+                    due.push_back(Task{PeriodicRunner{this, &timer}});
+            });
+
+            if (!due.empty())
+            {
+                lk.unlock();
+
+                for (auto& task : due)
+                    executor_.try_post(std::move(task)); // a rejected task is dropped
+                due.clear();
+
+                lk.lock();
+                continue;
+            }
+
+            const uint64_t planned_tick = wheel_.empty() ? std::numeric_limits<uint64_t>::max() : wheel_.current_tick() + wheel_.ticks_to_next_event();
+            wakeup_tick_ = planned_tick;
+
+            if (planned_tick == std::numeric_limits<uint64_t>::max())
+                cv_.wait(lk, stop_token, [&] { return wakeup_tick_ != planned_tick; });
+            else
+                cv_.wait_until(lk, stop_token, start_ + planned_tick * tick_, [&] { return wakeup_tick_ != planned_tick; });
+        }
+    }
+
+public:
+    explicit TimerService(Executor& executor, Clock::duration tick = std::chrono::milliseconds{1})
+        : executor_{executor}
+        , tick_{tick}
+        , start_{Clock::now()}
+    {
+        thread_ = std::jthread{[this](std::stop_token stop_token) { run(stop_token); }};
+    }
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    ~TimerService()
+    {
+        stop();
+    }
+
+    // runs task once after delay
+    TimerHandle post_after(Clock::duration delay, Task task)
+    {
+        return arm(delay, Clock::duration::zero(), std::move(task));
+    }
+
+    // runs task every period - the first run is after one period
+    TimerHandle post_every(Clock::duration period, Task task)
+    {
+        if (period <= Clock::duration::zero())
+            throw std::invalid_argument{"Timer period must be positive"};
+
+        return arm(period, period, std::move(task));
+    }
+
+    // O(1) - a running periodic task finishes its current run
+    bool cancel(uint32_t index, uint32_t generation)
+    {
+        Task dropped; // destroyed outside of the lock
+
+        std::lock_guard lk{mtx_};
+
+        Timer* timer = wheel_.find(index, generation);
+        if (!timer || timer->is_cancelled)
+            return false;
+
+        if (timer->state == TimerState::armed)
+        {
+            wheel_.unlink(*timer);
+            dropped = std::move(timer->task);
+            wheel_.release(*timer);
+        }
+        else
+            timer->is_cancelled = true;
+
+        return true;
+    }
+
+    // number of armed timers
+    size_t size()
+    {
+        std::lock_guard lk{mtx_};
+        return wheel_.size();
+    }
+
+    // Joins the timer thread & drops all pending timers
+    void stop()
+    {
+        std::vector<Task> dropped;
+
+        {
+            std::lock_guard lk{mtx_};
+
+            if (is_stopped_)
+                return;
+
+            is_stopped_ = true;
+            wheel_.clear([&](Timer& timer) {
+                dropped.push_back(std::move(timer.task));
+                wheel_.release(timer);
+            });
+        }
+
+        thread_.request_stop();
+        thread_.join();
+    }
+};
+
+inline bool TimerHandle::cancel()
+{
+    return service_ && service_->cancel(index_, generation_);
+}
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,60 @@
+#ifndef WORK_STEALING_QUEUE_HPP
+#define WORK_STEALING_QUEUE_HPP
+
+#include <deque>
+#include <mutex>
+
+// Per-worker deque: the owner pushes and pops at the back (LIFO - hot in cache),
+// other workers steal from the front (FIFO - the oldest, usually the biggest chunks of work)
+template <typename T>
+class WorkStealingQueue
+{
+    std::deque<T> q_;
+    mutable std::mutex mtx_q_;
+
+public:
+    WorkStealingQueue() = default;
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+    bool empty() const
+    {
+        std::lock_guard lk{mtx_q_};
+        return q_.empty();
+    }
+
+    void push(T&& item)
+    {
+        std::lock_guard lk{mtx_q_};
+        q_.push_back(std::move(item));
+    }
+
+    bool try_pop(T& item) // owner
+    {
+        std::lock_guard lk{mtx_q_};
+
+        if (q_.empty())
+            return false;
+
+        item = std::move_if_noexcept(q_.back());
+        q_.pop_back();
+
+        return true;
+    }
+
+    bool try_steal(T& item) // thieves
+    {
+        std::unique_lock lk{mtx_q_, std::try_to_lock};
+
+        if (!lk.owns_lock() || q_.empty())
+            return false;
+
+        item = std::move_if_noexcept(q_.front());
+        q_.pop_front();
+
+        return true;
+    }
+};
+
+#endif // WORK_STEALING_QUEUE_HPP
@@ -0,0 +1,100 @@
+#ifndef WORKER_LOCAL_HPP
+#define WORKER_LOCAL_HPP
+
+#include "thread_pool.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// One T per worker slot of a ThreadPool - created lazily by factory(slot) on the first local() call of a worker.
+// local() is a plain array access: no locks, no atomics & slots are cache-line aligned (no false sharing).
+// Typical use - RNGs, scratch buffers, arenas & partial results of a reduction:
+//   WorkerLocal<uint64_t> hits{pool};
+//   ... pool.submit([&] { hits.local() += count_hits(chunk); }) ...
+//   auto total = hits.combine_all(uint64_t{}, std::plus<>{}); // after all tasks are done
+// A new worker may inherit the value of a retired worker's slot.
+template <typename T>
+class WorkerLocal
+{
+    struct alignas(64) Slot
+    {
+        std::optional<T> value;
+    };
+
+    ThreadPool& pool_;
+    std::function<T(size_t)> factory_;
+    std::unique_ptr<Slot[]> slots_;
+    const size_t slots_count_;
+
+public:
+    explicit WorkerLocal(ThreadPool& pool)
+        requires std::default_initializable<T>
+        : WorkerLocal{pool, [](size_t) { return T{}; }}
+    {
+    }
+
+    // factory gets the worker's slot - e.g. to seed an RNG
+    WorkerLocal(ThreadPool& pool, std::function<T(size_t)> factory)
+        : pool_{pool}
+        , factory_{std::move(factory)}
+        , slots_{std::make_unique<Slot[]>(pool.max_slots())}
+        , slots_count_{pool.max_slots()}
+    {
+    }
+
+    WorkerLocal(const WorkerLocal&) = delete;
+    WorkerLocal& operator=(const WorkerLocal&) = delete;
+
+    // value of the calling worker - throws std::logic_error outside of the pool's workers
+    T& local()
+    {
+        const auto slot = pool_.worker_slot();
+        if (!slot)
+            throw std::logic_error{"WorkerLocal accessed outside of the pool's workers"};
+
+        auto& value = slots_[*slot].value;
+        if (!value)
+            value.emplace(factory_(*slot));
+
+        return *value;
+    }
+
+    // The functions below visit the values of all workers - they must not run concurrently with tasks using local()
+    // (e.g. call them after getting the futures of those tasks).
+
+    template <typename U, typename Combine>
+    U combine_all(U init, Combine combine) const
+    {
+        for (size_t i = 0; i < slots_count_; ++i)
+        {
+            if (slots_[i].value)
+                init = std::invoke(combine, std::move(init), *slots_[i].value);
+        }
+
+        return init;
+    }
+
+    template <typename Function>
+    void for_each(Function f)
+    {
+        for (size_t i = 0; i < slots_count_; ++i)
+        {
+            if (slots_[i].value)
+                std::invoke(f, *slots_[i].value);
+        }
+    }
+
+    // values are created again by the next local() calls
+    void clear()
+    {
+        for (size_t i = 0; i < slots_count_; ++i)
+            slots_[i].value.reset();
+    }
+};
+
+#endif // WORKER_LOCAL_HPP